@@ -11,6 +11,7 @@ output a desired velocity.
 
 #include "raylib.h"
 #include "raymath.h"
+#include "rng.h"
 
 #define MAX_SPEED 100.0f
 
@@ -58,10 +59,13 @@ KinematicSteeringOutput GetWander(KinematicWander* kinematicWander);
 float newOrientation(float currentOrientation, Vector2 velocity);
 float randomBinomial();
 
+static Rng wanderRng; // Seeded once in main, so a run can be reproduced
+
 int main(void) {
     const int screenWidth = 1280;
     const int screenHeight = 720;
     InitWindow(screenWidth, screenHeight, "Kinematic Seek and Flee");
+    wanderRng = RngStream(1, 0);
 
     KinematicCharacter character = { .position = {400, 300}, .orientation = 0 };
     KinematicCharacter target = { .position = {200, 200}, .orientation = 0 };
@@ -232,5 +236,5 @@ KinematicSteeringOutput GetWander(KinematicWander* kinematicWander) {
 
 float randomBinomial() {
     // Generate a random float between -1 and 1, with values around zero being more likely
-    return (GetRandomValue(0, 100) / 100.0f) - (GetRandomValue(0, 100) / 100.0f);
+    return RngBinomial(&wanderRng);
 }
@@ -0,0 +1,25 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "game.h"
+
+#define AUTOPILOT_FLEE_RADIUS 260.0f // Enemies further away than this are ignored
+#define AUTOPILOT_WALL_MARGIN 160.0f // Distance at which the arena edges start pushing back
+#define AUTOPILOT_POWER_UP_WEIGHT 0.6f // Pull of a power-up relative to a single enemy at the flee radius edge
+#define AUTOPILOT_WANDER_ROTATION 0.15f // Largest change of the wander orientation per tick, in radians
+#define AUTOPILOT_DEAD_ZONE 0.05f // Steering weaker than this leaves the keys released
+
+// Computer player for soak tests and benchmarks: flees the enemies around it, weighted by how close they
+// are, keeps off the walls, circles the crowd rather than backing straight into a corner, picks up power-ups
+// and wanders when nothing is near. Its output is the same direction bits a keyboard produces, so replays
+// and the state hash see no difference between it and a person.
+typedef struct Autopilot {
+    Rng rng; // Its own stream, past the game's and the scenario's, so a replay of its run hashes the same without it
+    float wanderOrientation; // Radians, drifts by RngBinomial each tick like KinematicWander in the examples
+    Vector2 heading; // Last steering direction, smoothed so the bot doesn't jitter between two keys
+} Autopilot;
+
+void InitAutopilot(Autopilot *autopilot, uint64_t seed);
+unsigned char UpdateAutopilot(Autopilot *autopilot, GameLogicParams *params); // REPLAY_INPUT_* direction bits for this tick
+
+#endif // AUTOPILOT_H
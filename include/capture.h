@@ -0,0 +1,59 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define CAPTURE_POOL_FRAMES 8 // Frames in flight at most; capture memory is this many RGBA frames plus their encode buffers
+#define CAPTURE_WORKERS 2
+
+typedef enum {
+    CAPTURE_PNG, // One numbered PNG per frame in a directory
+    CAPTURE_Y4M, // A single raw I420 stream with a YUV4MPEG2 header, for ffmpeg or any external encoder
+} CaptureFormat;
+
+typedef struct {
+    unsigned char *pixels; // RGBA, top row first
+    unsigned char *encoded; // Filled by the worker: I420 planes for Y4M, filtered PNG scanlines for PNG
+    long frame;
+} CaptureSlot;
+
+// Copies finished frames into a fixed pool of buffers and leaves encoding and file I/O to worker threads.
+// The main thread never waits: with every slot still queued or being encoded, the frame is counted as dropped
+// instead. Workers encode in any order; Y4M frames are written back in frame order so the stream stays valid.
+typedef struct {
+    CaptureFormat format;
+    const char *path; // Directory for PNG, file for Y4M
+    int width, height;
+    CaptureSlot slots[CAPTURE_POOL_FRAMES];
+    int freeSlots[CAPTURE_POOL_FRAMES]; // Stack of slot indices the main thread may fill
+    int freeCount;
+    int queue[CAPTURE_POOL_FRAMES]; // FIFO of filled slots waiting for a worker
+    int queueHead, queueCount;
+    pthread_mutex_t lock;
+    pthread_cond_t queued; // Signalled when a frame is queued or capture is stopping
+    pthread_cond_t frameWritten; // Signalled when a Y4M frame was written, for the worker holding the next one
+    pthread_t workers[CAPTURE_WORKERS];
+    int workerCount;
+    FILE *stream; // Y4M output
+    long nextWrite; // Next Y4M frame number due in the stream
+    long accepted; // Frames copied into a slot
+    long written;
+    long dropped; // Frames skipped because the pool was full
+    long failed; // Frames accepted but not written
+    bool stopping;
+    bool active;
+} Capture;
+
+// Allocates the pool and starts the workers; false (and nothing to unload) if any of it fails
+bool InitCapture(Capture *capture, CaptureFormat format, const char *path, int width, int height, int fps);
+
+// Drains every queued frame, joins the workers and logs the accounting
+void UnloadCapture(Capture *capture);
+
+// Reads back the finished frame; call after EndRenderFrame() has flushed the batch and before EndDrawing().
+// Returns false if the frame was dropped.
+bool CaptureFrame(Capture *capture);
+
+#endif // CAPTURE_H
@@ -0,0 +1,27 @@
+#ifndef DRAW_H
+#define DRAW_H
+
+#include "game.h"
+#include "hud.h"
+#include "telemetry.h"
+
+// Everything that draws: scenes, the world through the camera and the debug overlays. Kept apart from the
+// simulation in game.c, so the headless runner and the benchmarks link without the renderer or the HUD.
+void DrawEnemies(const GameView *view);
+void DrawParticles(const GameView *view);
+void DrawBullets(const GameView *view);
+void DrawLogo();
+void DrawMainMenu();
+Camera2D GetGameCamera(float arenaWidth, float arenaHeight, Vector2 target);
+Rectangle GetCameraView(Camera2D camera);
+void DrawArena(float arenaWidth, float arenaHeight, Rectangle view);
+void DrawGame(const GameView *game, Hud *hud);
+void DrawGameOver();
+void DrawDebugText(int count, ...);
+void DrawTelemetryOverlay(const Telemetry *telemetry, int x, int y);
+void DrawRenderStatsOverlay(int x, int y);
+#ifdef PROFILER_ENABLED
+void DrawProfilerOverlay(int x, int y);
+#endif
+
+#endif // DRAW_H
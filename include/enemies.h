@@ -0,0 +1,68 @@
+#ifndef ENEMIES_H
+#define ENEMIES_H
+
+#include <stdbool.h>
+#include "globals.h"
+#include "slotmap.h"
+#include "poolmem.h"
+#include "spatial.h"
+
+#define ENEMY_SPEED 100.0f
+#define ENEMY_RADIUS 15.0f
+
+#define SEPARATION_ITERATIONS 1 // Crowd solver passes per tick; overlap left over is resolved on later ticks
+#define SEPARATION_RELAXATION 0.8f // Fraction of each overlap resolved per pass
+#define SEPARATION_MAX_NEIGHBOURS 16 // Caps work per enemy inside dense blobs
+
+// Enemy flag bits
+#define ENEMY_FLAG_HIT_PLAYER 0x01 // Set by the update kernel when the enemy touched the player this tick
+#define ENEMY_FLAG_DEAD 0x02 // Killed by a bullet this tick; removed at the end of the collision pass
+
+// Enemy state stored as structure-of-arrays so the update kernel can stream it with SIMD loads.
+// Live enemies are packed in [0, slots.count); handles from the slot map stay valid across removals.
+// Each array is reserved for config.maxCapacity and committed in chunks, so it never moves.
+typedef struct {
+    float *x;
+    float *y;
+    float *radius;
+    unsigned char *flags;
+    float *previousX; // Position at the start of the last tick, for render interpolation
+    float *previousY;
+    float *pushX; // Scratch for SeparateEnemies
+    float *pushY;
+    SlotMap slots; // slots.capacity is the committed size of every array above
+    PoolConfig config;
+} Enemies;
+
+// Update kernel implementations, selected at runtime from the CPU features
+typedef enum {
+    ENEMY_KERNEL_AUTO,
+    ENEMY_KERNEL_SCALAR,
+    ENEMY_KERNEL_SSE2,
+    ENEMY_KERNEL_AVX2
+} EnemyKernel;
+
+void InitEnemies(Enemies *enemies, const PoolConfig *config);
+bool GrowEnemies(Enemies *enemies);
+void UnloadEnemies(Enemies *enemies);
+void ClearEnemies(Enemies *enemies);
+Handle AddEnemy(Enemies *enemies, float x, float y, float radius); // Grows the pool as needed; NULL_HANDLE at the ceiling
+void RemoveEnemy(Enemies *enemies, int index); // O(1) swap-remove: the last enemy moves into index
+void SaveEnemyPositions(Enemies *enemies); // Copies x, y into previousX, previousY before a tick moves them
+int RemoveFlaggedEnemies(Enemies *enemies, unsigned char flag);
+
+// Seek the player, integrate, clamp to the arena and flag enemies touching the player.
+// Returns the number of enemies flagged with ENEMY_FLAG_HIT_PLAYER.
+int SeekEnemies(Enemies *enemies, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime);
+
+// SeekEnemies over [start, end) only. Enemies don't interact here, so disjoint ranges may run on separate threads.
+int SeekEnemyRange(Enemies *enemies, int start, int end, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime);
+
+// Push overlapping enemies apart using neighbour queries on grid, which is rebuilt each iteration and left stale
+void SeparateEnemies(Enemies *enemies, SpatialGrid *grid, float arenaWidth, float arenaHeight, int iterations);
+
+void SetEnemyKernel(EnemyKernel kernel);
+EnemyKernel GetEnemyKernel(void);
+const char* EnemyKernelToString(EnemyKernel kernel);
+
+#endif // ENEMIES_H
@@ -1,3 +1,6 @@
+#ifndef GAME_H
+#define GAME_H
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -10,30 +13,42 @@
 #include "raymath.h"
 #include "resource_dir.h"
 #include "globals.h"
+#include "platform.h"
+#include "enemies.h"
+#include "particles.h"
+#include "slotmap.h"
+#include "spatial.h"
+#include "rng.h"
+#include "replay.h"
+
+// One random stream per subsystem, so adding draws to one never shifts the others
+typedef enum {
+    GAME_RNG_SPAWN, // Enemy spawn rolls and spawn positions
+    GAME_RNG_POWER_UP, // Power-up placement
+    GAME_RNG_STREAM_COUNT
+} GameRngStream;
 
 typedef struct {
     Vector2 position;
+    Vector2 previousPosition; // Position at the start of the last tick, for render interpolation
     float radius;
     int health;
 } Player;
 
 typedef struct {
     Vector2 position;
-    float radius;
-    Vector2 direction;
-} Enemy;
-
-typedef struct {
-    Vector2 position;
+    Vector2 previousPosition;
     Vector2 direction;
     float speed;
     float radius;
-    bool active; // To check if the bullet is active
+    bool active; // Cleared on hit; the bullet is removed on the next UpdateBullets
 } Bullet;
 
 typedef struct {
-    Bullet bullets[MAX_BULLETS]; // Array to hold bullets
-    int bulletCount; // Current number of active bullets
+    Bullet *bullets; // Dense array of live bullets, indexed through slots; reserved for the ceiling so it never moves
+    int *hits; // Scratch for CheckBulletEnemyCollisions, the enemy each bullet touches; reserved like bullets
+    SlotMap slots; // Handles and O(1) removal; slots.count is the number of live bullets
+    PoolConfig config;
     float lastShotTime; // Timer for shooting
     float bulletCooldown; // Time between shots
 } BulletManager;
@@ -41,32 +56,66 @@ typedef struct {
 typedef struct {
     Vector2 position;
     float radius;
-    bool active;
 } PowerUp;
 
 typedef struct {
-    Vector2 position;
-    Vector2 speed;
-    float life;
-    bool active;
-} Particle;
+    PowerUp powerUps[MAX_POWER_UPS]; // Dense array of live power-ups, indexed through slots
+    SlotMap slots;
+} PowerUpManager;
 
 typedef struct {
+    Platform *platform; // Input, arena bounds and clock used by the simulation
     Player *player;
     BulletManager *bulletManager;
-    Enemy enemies[MAX_ENEMIES];
-    int *enemyCount;
-    PowerUp *powerUp;
+    Enemies *enemies;
+    SpatialGrid *enemyGrid; // Enemy index for collisions and targeting, rebuilt every tick after they move
+    PowerUpManager *powerUpManager;
+    Particles *particles; // Debris from kills and pickups; cosmetic, nothing reads it back
     int *powerUpsCollected;
     int *enemiesShot;
     int *enemySpawnVar;
-    float deltaTime;
+    float deltaTime; // Length of one GameLogic tick
+    float accumulator; // Frame time not yet simulated, always less than one tick after StepGameLogic
+    float renderAlpha; // accumulator / deltaTime; draws blend previous and current positions by this much
     float *waveTimer;
     int *currentWave;
-    int *hitEnemyIndex;
+    Rng rng[GAME_RNG_STREAM_COUNT]; // Seeded by SeedGameRng
+    Replay *replay; // Records every tick's input when set
+    struct Autopilot *autopilot; // Steers the player instead of the keyboard when set, see autopilot.h
     bool isGamePaused;
+    bool useBroadphase; // false falls back to brute-force collision and targeting scans for cross-checking
+    int separationIterations; // Crowd separation passes per tick, 0 disables
 } GameLogicParams;
 
+// Everything DrawGame reads. GetGameView points it into the live simulation; the simulation thread
+// publishes copies instead (see simthread.h), so drawing never reads state a tick is changing.
+typedef struct {
+    Vector2 playerPosition;
+    Vector2 playerPreviousPosition;
+    float playerRadius;
+    int playerHealth;
+    const float *enemyX, *enemyY;
+    const float *enemyPreviousX, *enemyPreviousY;
+    const float *enemyRadius;
+    int enemyCount;
+    const Bullet *bullets;
+    int bulletCount;
+    const PowerUp *powerUps;
+    int powerUpCount;
+    const float *particleX, *particleY;
+    const float *particleVX, *particleVY; // Velocity over the last tick, to draw particles between ticks
+    const float *particleLife;
+    const Color *particleColor;
+    int particleCount;
+    int wave;
+    float waveTimer;
+    int enemiesShot;
+    int powerUpsCollected;
+    int enemySpawnVar; // Not drawn, but telemetry groups frames by it
+    int arenaWidth, arenaHeight;
+    float renderAlpha; // Blend between previous and current positions
+} GameView;
+
 typedef enum {
     LOGO,
     MAIN_MENU,
@@ -77,29 +126,32 @@ typedef enum {
 
 const char* SceneToString(Scene scene);
 
-void InitGameParams(GameLogicParams *params);
+void InitGameParams(GameLogicParams *params, Platform *platform);
+void SeedGameRng(GameLogicParams *params, uint64_t seed);
 void GameLogic(GameLogicParams *params);
-void InitPlayer(Player *player);
-void InitBulletManager(BulletManager *bulletManager);
+int StepGameLogic(GameLogicParams *params, float frameTime);
+void InitPlayer(Player *player, const Platform *platform);
+void InitBulletManager(BulletManager *bulletManager, const PoolConfig *config);
+bool GrowBulletManager(BulletManager *bulletManager);
+void ResetBulletManager(BulletManager *bulletManager);
 void SpawnEnemy(GameLogicParams *params);
 void UpdateEnemies(GameLogicParams *params);
 
-bool CheckCollision(Player *player, Enemy *enemy);
-void UpdatePlayer(Player *player, float deltaTime);
-void UpdateBullets(BulletManager *bulletManager, float deltaTime);
+unsigned char ReadPlayerInput(const Platform *platform); // REPLAY_INPUT_* direction bits from WASD or the arrow keys
+void UpdatePlayer(Player *player, unsigned char input, const Platform *platform, float deltaTime);
+void UpdateBullets(BulletManager *bulletManager, const Platform *platform, float deltaTime);
 
-void FireBullet(Player *player, BulletManager *bulletManager, Enemy enemies[], int enemyCount, int powerUpsCollected, float fireRateIncrease);
-Enemy* FindClosestEnemy(Enemy enemies[], int enemyCount, Player *player);
-void CheckBulletEnemyCollisions(BulletManager *bulletManager, Enemy enemies[], int *enemyCount, int *enemiesShot, int *hitEnemyIndex);
-void SpawnPowerUp(PowerUp *powerUp, Player *player);
-void CheckPowerUpCollection(Player *player, PowerUp *powerUp, int *powerUpsCollected);
+void FireBullet(Player *player, BulletManager *bulletManager, Enemies *enemies, const SpatialGrid *enemyGrid, int powerUpsCollected, float fireRateIncrease, float deltaTime);
+int FindClosestEnemy(Enemies *enemies, const SpatialGrid *enemyGrid, Player *player);
+int FindClosestEnemies(Enemies *enemies, const SpatialGrid *enemyGrid, Vector2 position, float range, int k, int *closest, float *closestDistanceSq);
+void CheckBulletEnemyCollisions(BulletManager *bulletManager, Enemies *enemies, const SpatialGrid *enemyGrid, int *enemiesShot, Particles *particles);
+void InitPowerUpManager(PowerUpManager *powerUpManager);
+void SpawnPowerUp(PowerUpManager *powerUpManager, Player *player, const Platform *platform, Rng *rng);
+void CheckPowerUpCollection(Player *player, PowerUpManager *powerUpManager, int *powerUpsCollected, Particles *particles);
 
 void ExitGameplay(GameLogicParams *gameParams);
+void UnloadGameParams(GameLogicParams *params);
+
+GameView GetGameView(const GameLogicParams *params);
 
-void DrawEnemies(GameLogicParams *params);
-void DrawBullets(BulletManager *bulletManager);
-void DrawLogo();
-void DrawMainMenu();
-void DrawGame(GameLogicParams *params);
-void DrawGameOver();
-void DrawDebugText(int count, ...);
+#endif // GAME_H
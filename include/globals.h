@@ -2,15 +2,39 @@
 #define GLOBALS_H
 
 #include "raylib.h" // Include raylib if needed
+#include "poolmem.h"
 
 #define PLAYER_SPEED 200.0f
-#define MAX_ENEMIES 100
 #define INITIAL_ENEMY_SPAWN_VAR 2 // Initial spawn chance for enemies
-#define MAX_BULLETS 100
+#define MAX_POWER_UPS 4
 #define SHOOTING_RANGE 500.0f // Define the shooting range
 #define WAVE_DURATION 30.0f
+#define ARENA_WIDTH 2560 // World size in pixels, independent of the window; the game shows it through a following Camera2D
+#define ARENA_HEIGHT 1440
+
+// Default entity pool sizes; enemyPoolConfig and bulletPoolConfig can be changed before InitGameParams()
+#define ENEMY_POOL_INITIAL 1024
+#define ENEMY_POOL_MAX (1 << 20) // Hard ceiling on live enemies
+#define BULLET_POOL_INITIAL 256
+#define BULLET_POOL_MAX (1 << 18) // Hard ceiling on live bullets
+#define POOL_GROW_CHUNK 4096 // Entities committed per growth step
+#define PARTICLE_POOL_MAX 100000 // Fixed particle budget, committed up front; bursts beyond it are dropped
+
+#define ENEMY_GRID_CELL_SIZE 32.0f // Broadphase cell size, about one enemy diameter
+
+// Items per ParallelFor chunk in the tick's data-parallel loops; large enough that a chunk outweighs taking it
+#define ENEMY_JOB_CHUNK 2048 // A multiple of 8 keeps every chunk on the AVX2 kernel's full lanes
+#define BULLET_JOB_CHUNK 2048
+#define COLLISION_JOB_CHUNK 256 // Bullets per chunk; each one searches the grid, so chunks are smaller
+
+#define GAME_DEFAULT_SEED 1 // main.c reseeds from the clock; every executable takes --seed
+
+#define TICK_RATE 120 // Simulation ticks per second, independent of the render frame rate
+#define FIXED_TIMESTEP (1.0f / TICK_RATE)
+#define MAX_CATCH_UP_STEPS 8 // Ticks run per frame at most; time beyond that is dropped instead of spiralling
 
 #define DEV_MODE
+#define PROFILER_ENABLED // Per-phase frame timers; comment out to compile every PROFILE_* hook to nothing
 
 // Define enums
 enum palette {
@@ -38,5 +62,7 @@ extern int enemySpawnVar; // Variable to control enemy spawn rate
 extern int powerUpsCollected; // Number of power-ups collected
 extern int enemiesShot; // Track number of enemies shot
 extern float fireRateIncrease; // 5% increase in fire rate
+extern PoolConfig enemyPoolConfig; // Enemy pool capacities
+extern PoolConfig bulletPoolConfig; // Bullet pool capacities
 
 #endif // GLOBALS_H
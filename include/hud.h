@@ -0,0 +1,27 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define HUD_HEIGHT 64 // Strip across the top of the screen holding both rows of HUD text
+
+// Health, wave, wave timer and kills, laid out once into a render texture and redrawn only when one of
+// them changes (the timer ticks once a second), so a frame costs one textured quad however busy the HUD is.
+typedef struct {
+    RenderTexture2D target;
+    int width;
+    int health, wave, secondsLeft, enemiesShot; // Values the texture shows
+    bool valid; // false until the first render
+    int redraws; // Times the texture was re-rendered
+} Hud;
+
+void InitHud(Hud *hud, int width); // After InitWindow
+void UnloadHud(Hud *hud);
+
+// Re-renders the texture if any value differs from what it shows; call before anything else is drawn this
+// frame, since switching to the render texture flushes rlgl's batch. Returns true when it re-rendered.
+bool UpdateHud(Hud *hud, int health, int wave, int secondsLeft, int enemiesShot);
+void DrawHud(const Hud *hud);
+
+#endif // HUD_H
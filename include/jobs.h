@@ -0,0 +1,24 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#define JOB_MAX_WORKERS 15 // Helper threads at most; the submitting thread always takes part too
+#define JOB_WORKERS_AUTO -1 // One helper per core beyond the submitting thread's
+#define JOB_SPIN_COUNT 4096 // Polls of the job generation before an idle worker sleeps; ticks submit in bursts
+
+// Runs fn over [start, end) of one chunk. Chunks of a ParallelFor may run in any order on any thread,
+// so fn must only write state owned by its range; reductions go through per-item output or atomics.
+typedef void (*JobFunction)(void *context, int start, int end);
+
+// Starts the pool with workers helper threads, 0 for none; JOB_WORKERS_AUTO sizes it to the machine.
+// Without a pool every ParallelFor runs inline on the caller.
+void InitJobSystem(int workers);
+void UnloadJobSystem(void);
+int GetJobWorkerCount(void);
+
+// Splits [0, count) into chunks of chunkSize items, runs fn on every chunk and returns once all are done.
+// Each participant starts with a contiguous share of the chunks, takes its own from the front and, once out,
+// steals the back half of another's, so a late or slow thread never holds up the rest. One thread submits
+// at a time; chunk boundaries depend only on count and chunkSize, never on the worker count.
+void ParallelFor(int count, int chunkSize, JobFunction fn, void *context);
+
+#endif // JOBS_H
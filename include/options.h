@@ -0,0 +1,26 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "enemies.h"
+
+// Command line options every executable takes, for its usage line
+#define SIM_OPTIONS_USAGE "[--seed S] [--kernel auto|scalar|sse2|avx2] [--jobs N]"
+
+// Simulation settings shared by the game, the headless runner and the benchmarks
+typedef struct {
+    uint64_t seed;
+    EnemyKernel kernel;
+    int jobWorkers; // Helper threads for InitJobSystem, 0 runs the data-parallel loops serially
+} SimOptions;
+
+// Defaults: GAME_DEFAULT_SEED, the best kernel the CPU has and a job worker per spare core
+void InitSimOptions(SimOptions *options);
+
+// Consumes argv[*i] and its value if it is one of the shared options, leaving *i on the last argument used.
+// Returns false for anything else, so the caller can try its own options; a shared option with a bad value,
+// such as an unknown --kernel, is left unconsumed too and ends up in the caller's usage error.
+bool ParseSimOption(SimOptions *options, int argc, char *argv[], int *i);
+
+#endif // OPTIONS_H
@@ -0,0 +1,47 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "rng.h"
+
+#define PARTICLE_RADIUS 3.0f // Size of a fresh particle; it shrinks to nothing as it ages
+#define PARTICLE_DRAG 3.0f // Fraction of velocity lost per second, applied per tick
+
+// Emitter presets
+#define ENEMY_DEATH_PARTICLES 24
+#define ENEMY_DEATH_PARTICLE_SPEED 180.0f
+#define ENEMY_DEATH_PARTICLE_LIFETIME 0.6f
+#define POWER_UP_PARTICLES 64
+#define POWER_UP_PARTICLE_SPEED 260.0f
+#define POWER_UP_PARTICLE_LIFETIME 0.9f
+
+// Cosmetic debris stored as structure-of-arrays for the SIMD age kernel. Live particles are packed in
+// [0, count); capacity is fixed at init and committed up front, so emits never allocate and are dropped once
+// the pool is full. Nothing in the simulation reads particles back, so they are not part of the state hash.
+typedef struct {
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *life; // Fraction of the lifetime left, 1 at emit; removed once it reaches 0
+    float *decay; // Life lost per second, 1 / lifetime
+    Color *color;
+    int count;
+    int capacity;
+    int dropped; // Emits refused because the pool was full
+    Rng rng; // Emit directions and speeds, separate from the game streams
+} Particles;
+
+void InitParticles(Particles *particles, int capacity);
+void UnloadParticles(Particles *particles);
+void ClearParticles(Particles *particles);
+
+// Burst of count particles from (x, y) in random directions, up to speed and lasting about lifetime seconds
+void EmitParticles(Particles *particles, float x, float y, int count, float speed, float lifetime, Color color);
+
+// Integrate, apply drag and age every particle, then swap-remove the expired ones. Runs the instruction
+// set picked by SetEnemyKernel, so one switch covers every SIMD path.
+void UpdateParticles(Particles *particles, float deltaTime);
+
+#endif // PARTICLES_H
@@ -0,0 +1,21 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdbool.h>
+
+// Everything the simulation needs from the outside world: input, arena bounds and clock.
+// The window build fills it from raylib, the headless build from fixed values and scripted keys.
+typedef struct {
+    bool (*IsKeyDown)(int key); // Current state of a keyboard key (raylib KeyboardKey codes)
+    int (*GetArenaWidth)(void); // Width of the play area in pixels
+    int (*GetArenaHeight)(void); // Height of the play area in pixels
+    float (*GetFrameTime)(void); // Seconds elapsed since the previous tick
+} Platform;
+
+void InitRaylibPlatform(Platform *platform);
+
+void InitHeadlessPlatform(Platform *platform, int arenaWidth, int arenaHeight, float frameTime);
+void SetHeadlessKeyDown(int key, bool down);
+void ClearHeadlessKeys(void);
+
+#endif // PLATFORM_H
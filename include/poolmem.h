@@ -0,0 +1,29 @@
+#ifndef POOLMEM_H
+#define POOLMEM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Capacity settings for a growable entity pool, chosen at startup
+typedef struct {
+    int initialCapacity; // Entities committed up front
+    int growChunk; // Entities committed per growth step
+    int maxCapacity; // Hard ceiling; address space for this many is reserved at init
+} PoolConfig;
+
+// Committed and reserved bytes across every pool, for diagnostics
+typedef struct {
+    size_t reservedBytes;
+    size_t committedBytes;
+} PoolMemoryStats;
+
+// Dedicated pool allocator: reserves address space for the hard ceiling once and commits pages as the
+// pool grows, so arrays never move and pointers into live entities stay valid across growth.
+void *ReservePoolMemory(size_t bytes);
+bool CommitPoolMemory(void *base, size_t committedBytes, size_t bytes); // Grow the committed prefix to bytes
+void ReleasePoolMemory(void *base, size_t reservedBytes, size_t committedBytes);
+
+int NextPoolCapacity(int capacity, const PoolConfig *config); // Next capacity step, or capacity if at the ceiling
+PoolMemoryStats GetPoolMemoryStats(void);
+
+#endif // POOLMEM_H
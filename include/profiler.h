@@ -0,0 +1,75 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include "globals.h" // PROFILER_ENABLED
+
+#define PROFILE_FRAME_COUNT 240 // Frames kept in the ring buffer, four seconds at 60 FPS
+#define PROFILE_MAX_EVENTS 256 // Timed scopes kept per frame for the trace; phase totals count every scope
+
+// Phases of a frame; GameLogic phases repeat once per fixed tick
+typedef enum {
+    PROFILE_INPUT,
+    PROFILE_BULLETS,
+    PROFILE_ENEMIES,
+    PROFILE_BROADPHASE,
+    PROFILE_FIRING,
+    PROFILE_COLLISIONS,
+    PROFILE_POWER_UPS,
+    PROFILE_SPAWNING,
+    PROFILE_WAVES,
+    PROFILE_PARTICLES,
+    PROFILE_DRAW,
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+typedef struct {
+    int phase;
+    float startUs; // Relative to the frame start
+    float durationUs;
+} ProfileEvent;
+
+// One ring buffer entry. sequence is odd while the writer fills the entry, so readers can
+// copy it without locking and retry if it changed underneath them.
+typedef struct {
+    unsigned int sequence;
+    unsigned long long frame; // Frame number since the profiler started
+    double startUs; // Absolute, from the profiler clock
+    float durationUs;
+    float phaseUs[PROFILE_PHASE_COUNT]; // Total time per phase this frame
+    int ticks; // Fixed ticks run this frame
+    int eventCount;
+    ProfileEvent events[PROFILE_MAX_EVENTS];
+} ProfileFrame;
+
+#ifdef PROFILER_ENABLED
+    // Scoped timers: PROFILE_BEGIN(phase) and PROFILE_END(phase) must pair up in the same block. Outside a
+    // frame (the headless runner without --trace, the benchmarks, other threads) they skip the clock entirely.
+    #define PROFILE_BEGIN_FRAME() ProfilerBeginFrame()
+    #define PROFILE_END_FRAME() ProfilerEndFrame()
+    #define PROFILE_TICK() ProfilerCountTick()
+    #define PROFILE_BEGIN(phase) double profileStart_##phase = ProfilerActive() ? ProfilerNowUs() : 0.0
+    #define PROFILE_END(phase) do { if (profileStart_##phase != 0.0) ProfilerRecord(phase, profileStart_##phase, ProfilerNowUs()); } while (0)
+
+    double ProfilerNowUs(void);
+    bool ProfilerActive(void); // A frame is open on this thread
+    void ProfilerBeginFrame(void);
+    void ProfilerEndFrame(void);
+    void ProfilerCountTick(void);
+    void ProfilerRecord(ProfilePhase phase, double startUs, double endUs);
+
+    // Copies the frame completed age frames ago (0 = latest); false if there is none or it was being overwritten
+    bool ProfilerReadFrame(int age, ProfileFrame *frame);
+    int ProfilerFrameCount(void); // Completed frames still in the ring buffer
+    bool ProfilerExportChromeTrace(const char *path); // Trace-event JSON for chrome://tracing or Perfetto
+    const char* ProfilePhaseToString(ProfilePhase phase);
+#else
+    // Compiled out: every hook expands to nothing
+    #define PROFILE_BEGIN_FRAME() ((void)0)
+    #define PROFILE_END_FRAME() ((void)0)
+    #define PROFILE_TICK() ((void)0)
+    #define PROFILE_BEGIN(phase) ((void)0)
+    #define PROFILE_END(phase) ((void)0)
+#endif
+
+#endif // PROFILER_H
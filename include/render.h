@@ -0,0 +1,111 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "raylib.h"
+
+#define CIRCLE_SPRITE_SIZE 64 // Pixels across the pre-rendered circle; mipmaps cover the small bullets
+#define CIRCLE_SPRITE_VERTICES 4 // One textured quad
+#define CIRCLE_CULL_MARGIN 32.0f // World pixels kept around the view, so nothing pops in at the screen edge
+#define CIRCLE_LOD_MAX_SEGMENTS 36 // What DrawCircleV always used; nothing on screen needs more
+#define CIRCLE_LOD_MIN_SEGMENTS 6
+#define CIRCLE_LOD_MAX_ERROR 0.5f // Screen pixels the tessellated edge may fall inside the true circle
+#define CIRCLE_LOD_IMPOSTOR_RADIUS 1.0f // Screen radius below which a circle is drawn as a one pixel impostor
+#define CIRCLE_LOD_TABLE_RADIUS 64 // Segment counts are tabulated per whole screen pixel of radius up to here
+#define CIRCLE_LIST_CHUNK 256 // Circles DrawCircleList picks LOD for in one pass before emitting them
+#define RENDER_BATCH_SENTINEL 0xFFFFFFFFu // Parked in the batch's last draw slot, which only rlDrawRenderBatch's reset writes
+
+// How entity circles reach rlgl's render batch
+typedef enum {
+    CIRCLE_PATH_SHAPES, // DrawCircleV per entity, the original path
+    CIRCLE_PATH_SPRITES // One textured quad per entity from a pre-rendered circle, a single texture for the whole run
+} CirclePath;
+
+// Counted since the last ResetCircleDrawStats. A flush is rlgl drawing its batch because it ran out of
+// room (RL_DEFAULT_BATCH_BUFFER_ELEMENTS quads), which costs a buffer upload and a draw call each time.
+typedef struct {
+    int circles; // Submitted to rlgl
+    int culled; // Skipped for lying outside the cull rectangle
+    int impostors; // Sub-pixel circles drawn as a single flat pixel quad
+    int vertices;
+    int flushes;
+} CircleDrawStats;
+
+// A draw list for DrawCircleList, structure-of-arrays like the entities it is filled from
+typedef struct {
+    Vector2 *center;
+    float *radius;
+    Color *color;
+    int count; // Entries filled by the caller
+    int capacity;
+} CircleList;
+
+void InitCircleRenderer(void); // After InitWindow, needs the GL context
+void UnloadCircleRenderer(void);
+void SetCirclePath(CirclePath path);
+CirclePath GetCirclePath(void);
+const char* CirclePathToString(CirclePath path);
+
+// Circles drawn between BeginCircles and EndCircles share one batch state; nothing else may draw in between.
+// Level of detail follows the radius on screen: the shapes path tessellates with just enough segments to keep
+// the edge within CIRCLE_LOD_MAX_ERROR, and on both paths sub-pixel circles become one pixel impostors.
+void BeginCircles(void);
+void DrawCircleBatched(Vector2 center, float radius, Color color); // Skipped without touching rlgl when culled
+void EndCircles(void);
+
+// Bulk path for whole entity populations: fill the renderer's list with count entries, then DrawCircleList
+// culls and picks the LOD of a chunk of circles at a time before emitting them. The list is reused by the next
+// BeginCircleList; NULL if it could not grow to count.
+CircleList* BeginCircleList(int count);
+void DrawCircleList(const CircleList *list); // Between BeginCircles and EndCircles
+
+// World-space view; circles entirely outside it and its margin are culled until ClearCircleCullRect
+void SetCircleCullRect(Rectangle view);
+void ClearCircleCullRect(void);
+void SetCircleZoom(float zoom); // Screen pixels per world unit for LOD, the camera's zoom; 1 by default
+
+void ResetCircleDrawStats(void);
+CircleDrawStats GetCircleDrawStats(void);
+
+// Parts of a frame the render batch statistics are attributed to
+typedef enum {
+    RENDER_SECTION_OTHER, // Menus and anything drawn outside a named section
+    RENDER_SECTION_HUD, // Re-rendering the HUD texture and drawing it
+    RENDER_SECTION_ARENA, // Floor grid, border, player and power-ups
+    RENDER_SECTION_ENEMIES,
+    RENDER_SECTION_PARTICLES,
+    RENDER_SECTION_BULLETS,
+    RENDER_SECTION_TEXT, // Debug text and overlays
+    RENDER_SECTION_COUNT
+} RenderSection;
+
+// What rlgl's render batch sent to the GPU. A flush is one rlDrawRenderBatch that had vertices to draw; it
+// issues one draw call per batch draw (a run of vertices sharing mode and texture, at most
+// RL_DEFAULT_BATCH_DRAWCALLS per flush), and a texture switch is a draw whose texture differs from the one before.
+typedef struct {
+    int flushes;
+    int drawCalls;
+    int vertices;
+    int textureSwitches;
+} RenderBatchStats;
+
+typedef struct {
+    RenderBatchStats sections[RENDER_SECTION_COUNT];
+    RenderBatchStats total;
+    int peakDraws; // Most draws one flush carried, against RL_DEFAULT_BATCH_DRAWCALLS
+} RenderFrameStats;
+
+// rlgl keeps its own batch private, so the statistics install an identical batch they can read. The batch is
+// sampled at section changes and before every flush the game knows about (BeginCircles, circle overflows,
+// FlushRenderBatch). A flush raylib triggers by itself in between is only seen afterwards: it is counted if the
+// last sample found vertices waiting, and whatever it drew after that sample is missed. After InitWindow;
+// everything is a no-op until then.
+void InitRenderBatchStats(void);
+void UnloadRenderBatchStats(void); // Before CloseWindow
+void BeginRenderFrame(void); // After BeginDrawing
+void BeginRenderSection(RenderSection section);
+void FlushRenderBatch(void); // Draw the batch now, counted; call before raylib functions that flush it anyway
+void EndRenderFrame(void); // Before EndDrawing; flushes the rest and publishes the frame's numbers
+const RenderFrameStats* GetRenderFrameStats(void); // Last completed frame
+const char* RenderSectionToString(RenderSection section);
+
+#endif // RENDER_H
@@ -0,0 +1,39 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define REPLAY_VERSION 1
+
+// Input bits sampled once per tick; WASD and the arrow keys fold into the same direction
+#define REPLAY_INPUT_UP 0x01
+#define REPLAY_INPUT_DOWN 0x02
+#define REPLAY_INPUT_LEFT 0x04
+#define REPLAY_INPUT_RIGHT 0x08
+#define REPLAY_INPUT_RESET 0x80 // ExitGameplay() ran before this tick (game over, back to menu)
+
+// Everything needed to rerun a session tick for tick: the seed and arena it started with and one
+// input byte per fixed tick. On disk the inputs are run-length encoded, since held keys repeat.
+typedef struct {
+    uint64_t seed;
+    int arenaWidth, arenaHeight;
+    int tickRate; // Must match TICK_RATE to play back
+    long tickCount;
+    unsigned char *inputs; // tickCount entries
+    long capacity;
+    bool pendingReset; // Folded into the next recorded tick
+} Replay;
+
+void InitReplay(Replay *replay, uint64_t seed, int arenaWidth, int arenaHeight);
+void UnloadReplay(Replay *replay);
+
+// Recording
+void RecordReplayTick(Replay *replay, unsigned char input); // Direction bits the tick runs with, from the keyboard or the autopilot
+void MarkReplayReset(Replay *replay);
+bool SaveReplay(const Replay *replay, const char *path);
+
+// Playback; the headless runner feeds each tick's input back through its scripted keys
+bool LoadReplay(Replay *replay, const char *path);
+
+#endif // REPLAY_H
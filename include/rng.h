@@ -0,0 +1,68 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+#define RNG_GAMMA 0x9E3779B97F4A7C15ULL // SplitMix64 increment, the golden ratio in 64-bit fixed point
+
+// Counter-based generator in the SplitMix64 style: value n of a stream is Mix(key + n * RNG_GAMMA).
+// There is no hidden state besides the counter, so a stream can be split, replayed, or read at any
+// index (RngAt) from any thread, and batched fills are a plain loop with independent iterations.
+typedef struct {
+    uint64_t key; // Identifies the stream; derived from a seed and stream id, never used raw
+    uint64_t counter; // Index of the next value
+} Rng;
+
+// SplitMix64 finalizer: a bijection on 64-bit values with full avalanche
+static inline uint64_t RngMix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Independent stream for (seed, streamId); the same pair always yields the same sequence
+static inline Rng RngStream(uint64_t seed, uint64_t streamId) {
+    Rng rng = { RngMix64(RngMix64(seed) ^ RngMix64(streamId + RNG_GAMMA)), 0 };
+    return rng;
+}
+
+// Child stream of a subsystem stream, e.g. one per entity, without touching the parent's counter
+static inline Rng RngSubStream(const Rng *parent, uint64_t id) {
+    return RngStream(parent->key, id);
+}
+
+static inline uint64_t RngAt(const Rng *rng, uint64_t index) {
+    return RngMix64(rng->key + index * RNG_GAMMA);
+}
+
+static inline uint64_t RngNext64(Rng *rng) {
+    return RngAt(rng, rng->counter++);
+}
+
+static inline uint32_t RngNextU32(Rng *rng) {
+    return (uint32_t)(RngNext64(rng) >> 32);
+}
+
+// Uniform in [0, 1), 24 bits so every value is exactly representable
+static inline float RngNextFloat(Rng *rng) {
+    return (float)(RngNextU32(rng) >> 8) * 0x1p-24f;
+}
+
+// Uniform integer in [min, max], inclusive like raylib's GetRandomValue
+static inline int RngRange(Rng *rng, int min, int max) {
+    if (max < min) { int t = min; min = max; max = t; }
+    uint64_t span = (uint64_t)((int64_t)max - min) + 1;
+    return (int)((int64_t)min + (int64_t)(((uint64_t)RngNextU32(rng) * span) >> 32)); // Multiply-shift, no modulo
+}
+
+// In [-1, 1], values around zero more likely
+static inline float RngBinomial(Rng *rng) {
+    return RngNextFloat(rng) - RngNextFloat(rng);
+}
+
+// Batched fills: consume count values from the stream, identical to count single calls
+void RngFillU32(Rng *rng, uint32_t *out, int count);
+void RngFillFloat(Rng *rng, float *out, int count);
+void RngFillRange(Rng *rng, int *out, int count, int min, int max);
+
+#endif // RNG_H
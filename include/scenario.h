@@ -0,0 +1,61 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+#define SCENARIO_MAX_BURSTS 64
+#define SCENARIO_MAX_VOLLEYS 64
+#define SCENARIO_NAME_LENGTH 64
+
+// Edge bits for bursts, matching SpawnEnemy's edges
+#define SCENARIO_EDGE_TOP 0x01
+#define SCENARIO_EDGE_BOTTOM 0x02
+#define SCENARIO_EDGE_LEFT 0x04
+#define SCENARIO_EDGE_RIGHT 0x08
+#define SCENARIO_EDGE_ALL 0x0F
+
+typedef struct {
+    long tick; // Applied right before this tick runs
+    int count; // Enemies, spread evenly over the edges
+    int edges;
+    long period; // Repeats every period ticks after the first, 0 for once
+} ScenarioBurst;
+
+typedef struct {
+    long tick; // Applied right before this tick runs
+    int count; // Bullets fired from the player in random directions
+    long period; // Repeats every period ticks after the first, 0 for once
+} ScenarioVolley;
+
+// A repeatable load for the headless runner. Text format, one "key value..." per line, '#' starts a comment:
+//   name, seed, ticks, warmup, width, height, wave, wave_timer, spawn_var, power_ups, health,
+//   enemies, bullets, budget_p99_ms, and any number of "burst TICK COUNT EDGES [PERIOD]" with EDGES
+//   being "all" or a comma list of top, bottom, left, right, and of "volley TICK COUNT [PERIOD]".
+//   A PERIOD repeats the burst or volley every PERIOD ticks from TICK on, to keep a load up for the whole run.
+typedef struct {
+    char name[SCENARIO_NAME_LENGTH];
+    uint64_t seed;
+    long ticks;
+    long warmupTicks; // Left out of the tick time statistics
+    int arenaWidth, arenaHeight;
+    int wave;
+    float waveTimer; // Seconds already elapsed in the starting wave
+    int enemySpawnVar;
+    int powerUpsCollected;
+    int playerHealth; // Set high to keep a death reset from wiping the load
+    int enemies; // Placed at random in the arena before the first tick
+    int bullets; // Fired from the player in random directions before the first tick
+    float budgetP99Ms; // 0 disables the check
+    ScenarioBurst bursts[SCENARIO_MAX_BURSTS];
+    int burstCount;
+    ScenarioVolley volleys[SCENARIO_MAX_VOLLEYS];
+    int volleyCount;
+} Scenario;
+
+bool LoadScenario(Scenario *scenario, const char *path);
+void ApplyScenario(const Scenario *scenario, GameLogicParams *params); // After InitGameParams and SeedGameRng
+void ApplyScenarioTick(const Scenario *scenario, GameLogicParams *params, long tick); // Before every tick
+
+#endif // SCENARIO_H
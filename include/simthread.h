@@ -0,0 +1,63 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include "game.h"
+
+#define SNAPSHOT_FRESH 0x4 // Set on the shared index when the writer published a snapshot the reader hasn't taken
+
+// A GameView that owns copies of the arrays it points to. Arrays grow as the population does and are
+// only ever resized by the writer, while the triple buffer guarantees the reader holds another slot.
+typedef struct {
+    GameView view;
+    float *enemyX, *enemyY, *enemyPreviousX, *enemyPreviousY, *enemyRadius;
+    int enemyCapacity;
+    Bullet *bullets;
+    int bulletCapacity;
+    float *particleX, *particleY, *particleVX, *particleVY, *particleLife;
+    Color *particleColor;
+    int particleCapacity;
+    PowerUp powerUps[MAX_POWER_UPS];
+    double publishTime; // GetTime() when published
+    float accumulator; // Simulation time not yet ticked at publishTime, for the render alpha
+    float stepMs; // Time the simulation thread spent in the StepGameLogic call behind this snapshot
+} GameSnapshot;
+
+// Lock-free triple buffer: the writer always has a slot to fill, the reader always has the latest complete
+// one, and the third is handed between them with a single atomic exchange. Neither side ever waits.
+typedef struct {
+    GameSnapshot slots[3];
+    int back; // Writer's slot
+    int front; // Reader's slot
+    int middle; // Slot in between, plus SNAPSHOT_FRESH; only touched atomically
+} SnapshotBuffer;
+
+// Runs StepGameLogic on its own thread against the wall clock and publishes a snapshot after each step,
+// so the main thread draws tick N while tick N+1 is being simulated. Input, pause and the autopilot reach
+// the thread through atomics; the main thread must not touch the GameLogicParams while it runs.
+typedef struct {
+    pthread_t thread;
+    GameLogicParams *params;
+    Platform *platform; // The params' own platform, swapped for one reading the latched input while running
+    SnapshotBuffer snapshots;
+    struct Autopilot *autopilot; // Requested autopilot, applied by the thread before each step
+    int input; // REPLAY_INPUT_* bits latched by the main thread each frame
+    int paused;
+    int running;
+} SimThread;
+
+void InitSimThread(SimThread *sim, GameLogicParams *params);
+void UnloadSimThread(SimThread *sim); // Stops the thread first
+void StartSimThread(SimThread *sim); // No-op if already running
+void StopSimThread(SimThread *sim); // Joins; afterwards the params may be used directly again
+
+void SetSimThreadInput(SimThread *sim, unsigned char input);
+void SetSimThreadPaused(SimThread *sim, bool paused);
+void SetSimThreadAutopilot(SimThread *sim, struct Autopilot *autopilot);
+
+// Latest published snapshot, with its view's renderAlpha set for the current time. Main thread only;
+// stays valid until the next call. fresh is set when it wasn't returned by an earlier call.
+const GameSnapshot* AcquireSnapshot(SimThread *sim, bool *fresh);
+
+#endif // SIMTHREAD_H
@@ -0,0 +1,38 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <stdbool.h>
+
+// Stable reference to a pooled entity. Generation 0 is never issued, so a zeroed Handle is always invalid.
+typedef struct {
+    int slot;
+    unsigned int generation;
+} Handle;
+
+#define NULL_HANDLE ((Handle){ -1, 0 })
+
+// Generational slot map: maps stable handles to indices in a dense array owned by the caller.
+// Live entries occupy dense indices [0, count). Insert appends at count, remove swaps the last
+// entry into the hole, so the caller must mirror both moves in its own dense storage.
+// Bookkeeping lives in pool memory reserved for maxCapacity, so growing never moves it.
+typedef struct {
+    int capacity; // Committed slots
+    int maxCapacity; // Hard ceiling
+    int count; // Number of live entries
+    unsigned int *generations; // Per slot, bumped on every removal
+    int *slotToDense; // Per slot, -1 when the slot is free
+    int *denseToSlot; // Per dense index; entries past count hold the free slots
+} SlotMap;
+
+void InitSlotMap(SlotMap *map, int capacity, int maxCapacity);
+bool GrowSlotMap(SlotMap *map, int capacity);
+void UnloadSlotMap(SlotMap *map);
+void ClearSlotMap(SlotMap *map);
+
+Handle SlotMapInsert(SlotMap *map); // New entry lives at dense index count - 1; NULL_HANDLE when capacity is used up
+int SlotMapRemove(SlotMap *map, int denseIndex); // Returns the dense index that was moved into denseIndex, or -1
+int SlotMapLookup(const SlotMap *map, Handle handle); // Dense index, or -1 if the handle is stale
+Handle SlotMapHandleAt(const SlotMap *map, int denseIndex);
+bool IsHandleValid(const SlotMap *map, Handle handle);
+
+#endif // SLOTMAP_H
@@ -0,0 +1,42 @@
+#ifndef SPATIAL_H
+#define SPATIAL_H
+
+#define SPATIAL_GRID_MAX_CELLS (1 << 20) // Cell size doubles until the grid fits
+
+// Uniform grid over a set of points, rebuilt from scratch each tick with a counting sort.
+// Items of cell c are items[cellStart[c] .. cellStart[c + 1]) in ascending index order,
+// which keeps every query that walks cells in a fixed order deterministic. Positions and radii
+// are copied into the same order so neighbour scans read contiguous memory.
+typedef struct {
+    float baseCellSize; // Requested cell size
+    float cellSize; // Cell size used by the last build
+    float invCellSize;
+    float originX, originY; // World position of cell (0, 0)
+    int columns, rows;
+    float maxRadius; // Largest item radius seen by the last build
+    int itemCount;
+
+    int *cellStart; // columns*rows + 1 entries
+    int *cellCursor; // Scratch for the scatter pass
+    int *items; // Item indices sorted by cell
+    int *itemCell; // Cell of each item
+    float *sortedX; // x[items[k]], y[items[k]] and radius[items[k]] for every k
+    float *sortedY;
+    float *sortedRadius;
+    int cellCapacity;
+    int itemCapacity;
+} SpatialGrid;
+
+void InitSpatialGrid(SpatialGrid *grid, float cellSize);
+void UnloadSpatialGrid(SpatialGrid *grid);
+void BuildSpatialGrid(SpatialGrid *grid, const float *x, const float *y, const float *radius, int count);
+
+// Cell coordinates covering the box [minX, maxX] x [minY, maxY], clamped to the grid
+void GetSpatialGridRange(const SpatialGrid *grid, float minX, float minY, float maxX, float maxY, int *column0, int *row0, int *column1, int *row1);
+
+// k nearest items strictly closer than maxDistance, sorted by squared distance then index.
+// Writes up to k indices to nearest and their squared distances to nearestDistanceSq; returns how many were found.
+int QuerySpatialGridNearest(const SpatialGrid *grid, float px, float py, float maxDistance, int k, int *nearest, float *nearestDistanceSq);
+int QueryNearestBruteForce(const float *x, const float *y, int count, float px, float py, float maxDistance, int k, int *nearest, float *nearestDistanceSq);
+
+#endif // SPATIAL_H
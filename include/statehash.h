@@ -0,0 +1,39 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "game.h"
+
+// Parts of the simulation hashed separately, so a divergence can be traced to where it started
+typedef enum {
+    STATE_PLAYER, // Position, radius, health
+    STATE_ENEMIES, // Live enemies in dense order: position, radius, flags
+    STATE_BULLETS, // Live bullets in dense order, plus the shot timer and cooldown
+    STATE_POWER_UPS,
+    STATE_COUNTERS, // Power-ups collected, enemies shot, spawn variable
+    STATE_WAVE, // Current wave and wave timer
+    STATE_RNG, // Stream counters, which drift as soon as one build draws a different number of values
+    STATE_FIELD_COUNT
+} StateField;
+
+// Hash of the full game state after one tick. Floats are hashed by bit pattern, so two builds
+// only agree when they are bit-identical, not merely close.
+typedef struct {
+    uint64_t fields[STATE_FIELD_COUNT];
+    uint64_t combined; // Over all the fields, for a quick equality check
+} StateHash;
+
+void HashGameState(const GameLogicParams *params, StateHash *hash);
+const char* StateFieldToString(StateField field);
+
+// Hash log: one text line per tick, "tick combined field...", in hex, so two logs can also be diffed by hand
+bool WriteStateHashHeader(FILE *file);
+void WriteStateHash(FILE *file, long tick, const StateHash *hash);
+bool ReadStateHash(FILE *file, long *tick, StateHash *hash); // Skips the header; false at the end or on a bad line
+
+// Index of the first field that differs, or -1 when the hashes match
+int FindStateHashDivergence(const StateHash *a, const StateHash *b);
+
+#endif // STATEHASH_H
@@ -0,0 +1,58 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "render.h"
+
+// Log-linear (HDR-style) buckets over microseconds: exact below 128 us, then 64 buckets per
+// power of two, so every recorded value is kept to within 1.6% up to the 67 s ceiling.
+#define HISTOGRAM_SUB_BUCKETS 64
+#define HISTOGRAM_MAX_BIT 26 // Values are clamped below 2^26 us
+#define HISTOGRAM_BUCKETS (2 * HISTOGRAM_SUB_BUCKETS + (HISTOGRAM_MAX_BIT - 7) * HISTOGRAM_SUB_BUCKETS)
+
+#define TELEMETRY_SPARKLINE_FRAMES 240 // Frame times kept for the overlay
+
+typedef struct {
+    uint32_t counts[HISTOGRAM_BUCKETS];
+    uint64_t totalCount;
+    uint64_t sumUs;
+    uint32_t minUs, maxUs;
+} Histogram;
+
+typedef enum {
+    TELEMETRY_FRAME, // Whole frame as raylib measured it, including the wait for the target FPS
+    TELEMETRY_UPDATE, // Fixed ticks run this frame
+    TELEMETRY_DRAW, // Scene draw calls, before EndDrawing flushes them
+    TELEMETRY_TIME_METRIC_COUNT,
+    // Render batch counts per frame, see RenderBatchStats; kept in the same histograms, one count per "us"
+    TELEMETRY_FLUSHES = TELEMETRY_TIME_METRIC_COUNT,
+    TELEMETRY_DRAW_CALLS,
+    TELEMETRY_VERTICES,
+    TELEMETRY_TEXTURE_SWITCHES,
+    TELEMETRY_METRIC_COUNT
+} TelemetryMetric;
+
+// Per-wave timing histograms. The histograms are summarised and cleared whenever the wave changes,
+// so each CSV row describes one wave, together with the spawn rate it ran at.
+typedef struct {
+    Histogram histograms[TELEMETRY_METRIC_COUNT];
+    int wave; // Wave the histograms belong to, 0 before the first frame
+    int enemySpawnVar; // Highest spawn variable seen during the wave
+    int peakEnemies;
+    float sparkline[TELEMETRY_SPARKLINE_FRAMES]; // Frame times in ms, ring buffer
+    int sparklineNext;
+    FILE *csv; // NULL when not dumping
+} Telemetry;
+
+void ResetHistogram(Histogram *histogram);
+void RecordHistogram(Histogram *histogram, uint32_t valueUs);
+uint32_t GetHistogramPercentile(const Histogram *histogram, double percentile); // percentile in [0, 100], result in us
+
+bool InitTelemetry(Telemetry *telemetry, const char *csvPath); // csvPath may be NULL; false if it can't be opened
+void RecordTelemetryFrame(Telemetry *telemetry, float frameMs, float updateMs, float drawMs, const RenderBatchStats *batch, int wave, int enemySpawnVar, int enemies);
+void FlushTelemetry(Telemetry *telemetry); // Summarise the current wave to the log and CSV, then clear it
+void UnloadTelemetry(Telemetry *telemetry); // Flushes and closes the CSV
+
+#endif // TELEMETRY_H
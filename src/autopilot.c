@@ -0,0 +1,105 @@
+#include "autopilot.h"
+#include <math.h>
+
+void InitAutopilot(Autopilot *autopilot, uint64_t seed) {
+    autopilot->rng = RngStream(seed, GAME_RNG_STREAM_COUNT + 1);
+    autopilot->wanderOrientation = 0.0f;
+    autopilot->heading = (Vector2){ 0.0f, 0.0f };
+}
+
+//
+/* Steering: each behaviour adds a desired direction, weighted by urgency; the sum is quantised to the 8 key directions. */
+//
+
+// Sum of unit vectors away from nearby enemies, each scaled by how far inside the flee radius it is.
+// A plain scan: the spatial grid is stale at input time, and this is one pass per tick like SeekEnemies.
+static Vector2 GetFleeSteering(const Enemies *enemies, Vector2 position, float *threat) {
+    Vector2 flee = { 0.0f, 0.0f };
+    const float radiusSq = AUTOPILOT_FLEE_RADIUS * AUTOPILOT_FLEE_RADIUS;
+    *threat = 0.0f;
+
+    for (int i = 0; i < enemies->slots.count; i++) {
+        float dx = position.x - enemies->x[i];
+        float dy = position.y - enemies->y[i];
+        float distanceSq = dx * dx + dy * dy;
+        if (distanceSq >= radiusSq || distanceSq < 1e-6f) continue;
+
+        float distance = sqrtf(distanceSq);
+        float weight = (AUTOPILOT_FLEE_RADIUS - distance) / AUTOPILOT_FLEE_RADIUS;
+        weight *= weight; // Close enemies dominate
+        flee.x += dx / distance * weight;
+        flee.y += dy / distance * weight;
+        *threat += weight;
+    }
+    return flee;
+}
+
+// Push back from each edge inside the margin, growing steeply near the wall
+static Vector2 GetWallSteering(Vector2 position, float arenaWidth, float arenaHeight) {
+    Vector2 push = { 0.0f, 0.0f };
+    float left = position.x / AUTOPILOT_WALL_MARGIN;
+    float right = (arenaWidth - position.x) / AUTOPILOT_WALL_MARGIN;
+    float top = position.y / AUTOPILOT_WALL_MARGIN;
+    float bottom = (arenaHeight - position.y) / AUTOPILOT_WALL_MARGIN;
+
+    if (left < 1.0f) push.x += (1.0f - left) * (1.0f - left) * 4.0f;
+    if (right < 1.0f) push.x -= (1.0f - right) * (1.0f - right) * 4.0f;
+    if (top < 1.0f) push.y += (1.0f - top) * (1.0f - top) * 4.0f;
+    if (bottom < 1.0f) push.y -= (1.0f - bottom) * (1.0f - bottom) * 4.0f;
+    return push;
+}
+
+static Vector2 GetPowerUpSteering(const PowerUpManager *powerUpManager, Vector2 position) {
+    float closestDistanceSq = FLT_MAX;
+    Vector2 seek = { 0.0f, 0.0f };
+    for (int i = 0; i < powerUpManager->slots.count; i++) {
+        Vector2 toPowerUp = Vector2Subtract(powerUpManager->powerUps[i].position, position);
+        float distanceSq = Vector2LengthSqr(toPowerUp);
+        if (distanceSq < closestDistanceSq) {
+            closestDistanceSq = distanceSq;
+            seek = Vector2Normalize(toPowerUp);
+        }
+    }
+    return seek;
+}
+
+unsigned char UpdateAutopilot(Autopilot *autopilot, GameLogicParams *params) {
+    const Player *player = params->player;
+    float arenaWidth = (float)params->platform->GetArenaWidth();
+    float arenaHeight = (float)params->platform->GetArenaHeight();
+
+    float threat;
+    Vector2 flee = GetFleeSteering(params->enemies, player->position, &threat);
+    Vector2 wall = GetWallSteering(player->position, arenaWidth, arenaHeight);
+
+    // Kite: slide sideways around the crowd instead of straight away from it, turning towards the open side
+    Vector2 desired = flee;
+    if (threat > 0.0f) {
+        Vector2 tangent = { -flee.y, flee.x };
+        Vector2 toCentre = { arenaWidth * 0.5f - player->position.x, arenaHeight * 0.5f - player->position.y };
+        if (Vector2DotProduct(tangent, toCentre) < 0.0f) tangent = Vector2Negate(tangent);
+        desired = Vector2Add(desired, Vector2Scale(tangent, 0.5f));
+    }
+    desired = Vector2Add(desired, Vector2Scale(wall, 1.0f + threat));
+
+    // Go for a power-up when one is out; with none and nothing close, wander so the crowd never settles
+    if (params->powerUpManager->slots.count > 0) {
+        desired = Vector2Add(desired, Vector2Scale(GetPowerUpSteering(params->powerUpManager, player->position), AUTOPILOT_POWER_UP_WEIGHT));
+    }
+    else if (threat < 0.1f) {
+        autopilot->wanderOrientation += RngBinomial(&autopilot->rng) * AUTOPILOT_WANDER_ROTATION;
+        desired = Vector2Add(desired, Vector2Scale((Vector2){ cosf(autopilot->wanderOrientation), sinf(autopilot->wanderOrientation) }, 0.3f));
+    }
+
+    autopilot->heading = Vector2Lerp(autopilot->heading, desired, 0.5f);
+    if (Vector2Length(autopilot->heading) < AUTOPILOT_DEAD_ZONE) return 0;
+
+    // Quantise to the nearest of the 8 directions a keyboard can press
+    float angle = atan2f(autopilot->heading.y, autopilot->heading.x);
+    int sector = ((int)floorf(angle / (PI / 4.0f) + 0.5f) + 8) % 8; // 0 is +x, counting towards +y
+    static const unsigned char sectorInputs[8] = {
+        REPLAY_INPUT_RIGHT, REPLAY_INPUT_RIGHT | REPLAY_INPUT_DOWN, REPLAY_INPUT_DOWN, REPLAY_INPUT_DOWN | REPLAY_INPUT_LEFT,
+        REPLAY_INPUT_LEFT, REPLAY_INPUT_LEFT | REPLAY_INPUT_UP, REPLAY_INPUT_UP, REPLAY_INPUT_UP | REPLAY_INPUT_RIGHT
+    };
+    return sectorInputs[sector];
+}
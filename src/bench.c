@@ -0,0 +1,261 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+
+#include "game.h"
+#include "globals.h"
+#include "jobs.h"
+#include "options.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// Micro-benchmarks for the simulation hot paths on synthetic populations, headless.
+// Every sample starts from the same population (rebuilt untimed), so samples are comparable.
+#define BENCH_USAGE "[--max-entities N] " SIM_OPTIONS_USAGE " [--json FILE]"
+
+#ifndef BENCH_BUILD_FLAGS
+#define BENCH_BUILD_FLAGS "unknown" // The Makefile passes its optimization flags; a hand-made build doesn't
+#endif
+
+#define BENCH_MAX_RESULTS 64
+#define BENCH_ENEMY_SPACING 40.0f // Arena side grows with sqrt(population) so density stays the same
+#define BENCH_QUERIES 1000 // FindClosestEnemy calls per population
+#define BENCH_SPAWNS 1000 // SpawnEnemy calls per population
+
+typedef struct {
+    const char *name;
+    int entities; // Population size
+    int samples;
+    double nsPerEntity; // Median call time divided by the entities one call processes
+    double p50Ns;
+    double p99Ns;
+    double meanNs;
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int resultCount = 0;
+
+static double GetWallTimeNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void RecordResult(const char *name, int entities, int perCall, double *samples, int count) {
+    qsort(samples, count, sizeof(double), CompareDoubles);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += samples[i];
+
+    int p99 = (int)ceil(0.99 * count) - 1;
+    BenchResult result = {
+        name, entities, count,
+        samples[count / 2] / perCall,
+        samples[count / 2],
+        samples[(p99 > 0) ? p99 : 0],
+        sum / count
+    };
+
+    printf("%-28s %8d %8d %12.2f %14.0f %14.0f\n", name, entities, count, result.nsPerEntity, result.p50Ns, result.p99Ns);
+    if (resultCount < BENCH_MAX_RESULTS) results[resultCount++] = result;
+}
+
+static int GetSampleCount(int entities) {
+    int samples = 20000000 / entities;
+    if (samples < 25) return 25;
+    if (samples > 1000) return 1000;
+    return samples;
+}
+
+//
+/* Synthetic populations: uniform positions in the arena, drawn from a fixed stream so every run matches. */
+//
+static void FillEnemies(Enemies *enemies, int count, float arenaSize, uint64_t seed) {
+    Rng rng = RngStream(seed, 0);
+    ClearEnemies(enemies);
+    for (int i = 0; i < count; i++) {
+        AddEnemy(enemies, RngNextFloat(&rng) * arenaSize, RngNextFloat(&rng) * arenaSize, ENEMY_RADIUS);
+    }
+}
+
+static void FillBullets(BulletManager *bulletManager, int count, float arenaSize, uint64_t seed) {
+    Rng rng = RngStream(seed, 1);
+    ClearSlotMap(&bulletManager->slots);
+    for (int i = 0; i < count; i++) {
+        bool hasRoom = (bulletManager->slots.count < bulletManager->slots.capacity) || GrowBulletManager(bulletManager);
+        if (!hasRoom || SlotMapInsert(&bulletManager->slots).generation == 0) break;
+
+        float angle = RngNextFloat(&rng) * 2.0f * PI;
+        Bullet *bullet = &bulletManager->bullets[bulletManager->slots.count - 1];
+        bullet->position = (Vector2){ RngNextFloat(&rng) * arenaSize, RngNextFloat(&rng) * arenaSize };
+        bullet->previousPosition = bullet->position;
+        bullet->direction = (Vector2){ cosf(angle), sinf(angle) };
+        bullet->speed = PLAYER_SPEED * 4;
+        bullet->radius = 5.0f;
+        bullet->active = true;
+    }
+}
+
+// Enemy-death bursts scattered over the arena until the population is reached or the pool is full
+static void FillParticles(Particles *particles, int count, float arenaSize, uint64_t seed) {
+    Rng rng = RngStream(seed, 3);
+    ClearParticles(particles);
+    particles->rng = RngStream(seed, 4);
+    while (particles->count < count && particles->count < particles->capacity) {
+        int burst = (count - particles->count < ENEMY_DEATH_PARTICLES) ? count - particles->count : ENEMY_DEATH_PARTICLES;
+        EmitParticles(particles, RngNextFloat(&rng) * arenaSize, RngNextFloat(&rng) * arenaSize, burst, ENEMY_DEATH_PARTICLE_SPEED, ENEMY_DEATH_PARTICLE_LIFETIME, WHITE);
+    }
+}
+
+static void BenchPopulation(GameLogicParams *params, Platform *platform, int entities, uint64_t seed) {
+    float arenaSize = BENCH_ENEMY_SPACING * sqrtf((float)entities);
+    if (arenaSize < 800.0f) arenaSize = 800.0f;
+    InitHeadlessPlatform(platform, (int)arenaSize, (int)arenaSize, FIXED_TIMESTEP);
+
+    int samples = GetSampleCount(entities);
+    double *times = malloc(((samples > BENCH_QUERIES) ? samples : BENCH_QUERIES) * sizeof(double));
+
+    Player *player = params->player;
+    player->position = (Vector2){ arenaSize * 0.5f, arenaSize * 0.5f };
+    player->health = 1 << 30; // Enemies reaching the player never end the run
+
+    for (int s = 0; s < samples; s++) {
+        FillEnemies(params->enemies, entities, arenaSize, seed);
+        double start = GetWallTimeNs();
+        UpdateEnemies(params);
+        times[s] = GetWallTimeNs() - start;
+    }
+    RecordResult("UpdateEnemies", entities, entities, times, samples);
+
+    for (int s = 0; s < samples; s++) {
+        FillBullets(params->bulletManager, entities, arenaSize, seed);
+        double start = GetWallTimeNs();
+        UpdateBullets(params->bulletManager, platform, FIXED_TIMESTEP);
+        times[s] = GetWallTimeNs() - start;
+    }
+    RecordResult("UpdateBullets", entities, entities, times, samples);
+
+    FillEnemies(params->enemies, entities, arenaSize, seed);
+    for (int s = 0; s < samples; s++) {
+        Enemies *enemies = params->enemies;
+        double start = GetWallTimeNs();
+        BuildSpatialGrid(params->enemyGrid, enemies->x, enemies->y, enemies->radius, enemies->slots.count);
+        times[s] = GetWallTimeNs() - start;
+    }
+    RecordResult("BuildSpatialGrid", entities, entities, times, samples);
+
+    for (int s = 0; s < samples; s++) {
+        Enemies *enemies = params->enemies;
+        FillEnemies(enemies, entities, arenaSize, seed);
+        FillBullets(params->bulletManager, entities, arenaSize, seed);
+        BuildSpatialGrid(params->enemyGrid, enemies->x, enemies->y, enemies->radius, enemies->slots.count);
+        ClearParticles(params->particles);
+        double start = GetWallTimeNs();
+        CheckBulletEnemyCollisions(params->bulletManager, enemies, params->enemyGrid, params->enemiesShot, params->particles);
+        times[s] = GetWallTimeNs() - start;
+    }
+    RecordResult("CheckBulletEnemyCollisions", entities, entities, times, samples);
+
+    // Particles are capped by their fixed pool, so large populations measure a full pool
+    int particles = (entities < params->particles->capacity) ? entities : params->particles->capacity;
+    for (int s = 0; s < samples && particles > 0; s++) {
+        FillParticles(params->particles, particles, arenaSize, seed);
+        double start = GetWallTimeNs();
+        UpdateParticles(params->particles, FIXED_TIMESTEP);
+        times[s] = GetWallTimeNs() - start;
+    }
+    if (particles > 0) RecordResult("UpdateParticles", particles, particles, times, samples);
+
+    // One query per sample from a random player position; a single call touches a handful of cells
+    FillEnemies(params->enemies, entities, arenaSize, seed);
+    BuildSpatialGrid(params->enemyGrid, params->enemies->x, params->enemies->y, params->enemies->radius, params->enemies->slots.count);
+    Rng rng = RngStream(seed, 2);
+    volatile int sink = 0;
+    for (int s = 0; s < BENCH_QUERIES; s++) {
+        player->position = (Vector2){ RngNextFloat(&rng) * arenaSize, RngNextFloat(&rng) * arenaSize };
+        double start = GetWallTimeNs();
+        sink += FindClosestEnemy(params->enemies, params->enemyGrid, player);
+        times[s] = GetWallTimeNs() - start;
+    }
+    (void)sink;
+    RecordResult("FindClosestEnemy", entities, entities, times, BENCH_QUERIES);
+
+    // Spawning adds one enemy per call on top of the population
+    FillEnemies(params->enemies, entities, arenaSize, seed);
+    for (int s = 0; s < BENCH_SPAWNS; s++) {
+        double start = GetWallTimeNs();
+        SpawnEnemy(params);
+        times[s] = GetWallTimeNs() - start;
+    }
+    RecordResult("SpawnEnemy", entities, 1, times, BENCH_SPAWNS);
+
+    free(times);
+}
+
+static bool WriteJson(const char *path, uint64_t seed) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n  \"kernel\": \"%s\",\n  \"job_workers\": %d,\n  \"build_flags\": \"%s\",\n  \"compiler_version\": \"%s\",\n  \"seed\": %llu,\n  \"benchmarks\": [\n",
+        EnemyKernelToString(GetEnemyKernel()), GetJobWorkerCount(), BENCH_BUILD_FLAGS, __VERSION__, (unsigned long long)seed);
+    for (int i = 0; i < resultCount; i++) {
+        BenchResult *r = &results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"entities\": %d, \"samples\": %d, \"ns_per_entity\": %.3f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, \"mean_ns\": %.0f}%s\n",
+            r->name, r->entities, r->samples, r->nsPerEntity, r->p50Ns, r->p99Ns, r->meanNs, (i + 1 < resultCount) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int maxEntities = 1000000;
+    const char *jsonPath = NULL;
+    SimOptions options;
+    InitSimOptions(&options);
+
+    for (int i = 1; i < argc; i++) {
+        if (ParseSimOption(&options, argc, argv, &i)) continue;
+        if (strcmp(argv[i], "--max-entities") == 0 && i + 1 < argc) maxEntities = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s " BENCH_USAGE "\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetEnemyKernel(options.kernel);
+    InitJobSystem(options.jobWorkers);
+
+    // Bullets are benchmarked at the same populations as enemies, so lift their ceiling too
+    bulletPoolConfig.maxCapacity = enemyPoolConfig.maxCapacity;
+
+    Platform platform;
+    InitHeadlessPlatform(&platform, 1280, 720, FIXED_TIMESTEP);
+
+    GameLogicParams gameLogicParams;
+    InitGameParams(&gameLogicParams, &platform);
+    SeedGameRng(&gameLogicParams, options.seed);
+
+    printf("kernel: %s, job workers: %d, build flags: %s\n", EnemyKernelToString(GetEnemyKernel()), GetJobWorkerCount(), BENCH_BUILD_FLAGS);
+    printf("%-28s %8s %8s %12s %14s %14s\n", "benchmark", "entities", "samples", "ns/entity", "p50 ns", "p99 ns");
+    for (int entities = 100; entities <= maxEntities; entities *= 10) {
+        if (entities + BENCH_SPAWNS > enemyPoolConfig.maxCapacity) break;
+        BenchPopulation(&gameLogicParams, &platform, entities, options.seed);
+    }
+
+    UnloadGameParams(&gameLogicParams);
+    UnloadJobSystem();
+
+    if (jsonPath != NULL && !WriteJson(jsonPath, options.seed)) {
+        fprintf(stderr, "Could not write %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,308 @@
+#include "capture.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+/* Encoding, on the worker threads */
+//
+
+static size_t GetEncodedSize(CaptureFormat format, int width, int height) {
+    if (format == CAPTURE_Y4M) return (size_t)width * height * 3 / 2;
+    return (size_t)height * (1 + (size_t)width * 4); // A filter byte in front of every row
+}
+
+// RGBA to I420 with the BT.601 limited-range integer coefficients; chroma is the average of each 2x2 block
+static void ConvertToI420(const CaptureSlot *slot, int width, int height) {
+    unsigned char *yPlane = slot->encoded;
+    unsigned char *uPlane = yPlane + width * height;
+    unsigned char *vPlane = uPlane + (width / 2) * (height / 2);
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char *row = slot->pixels + (size_t)y * width * 4;
+        for (int x = 0; x < width; x++) {
+            int r = row[x * 4], g = row[x * 4 + 1], b = row[x * 4 + 2];
+            yPlane[y * width + x] = (unsigned char)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        }
+    }
+
+    for (int y = 0; y < height / 2; y++) {
+        const unsigned char *top = slot->pixels + (size_t)(y * 2) * width * 4;
+        const unsigned char *bottom = top + (size_t)width * 4;
+        for (int x = 0; x < width / 2; x++) {
+            int r = top[x * 8] + top[x * 8 + 4] + bottom[x * 8] + bottom[x * 8 + 4];
+            int g = top[x * 8 + 1] + top[x * 8 + 5] + bottom[x * 8 + 1] + bottom[x * 8 + 5];
+            int b = top[x * 8 + 2] + top[x * 8 + 6] + bottom[x * 8 + 2] + bottom[x * 8 + 6];
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            uPlane[y * (width / 2) + x] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            vPlane[y * (width / 2) + x] = (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+static bool WriteY4MFrame(Capture *capture, const CaptureSlot *slot) {
+    size_t bytes = GetEncodedSize(CAPTURE_Y4M, capture->width, capture->height);
+    return (fputs("FRAME\n", capture->stream) >= 0) && (fwrite(slot->encoded, 1, bytes, capture->stream) == bytes);
+}
+
+static void PutBigEndian32(unsigned char *bytes, uint32_t value) {
+    bytes[0] = (unsigned char)(value >> 24);
+    bytes[1] = (unsigned char)(value >> 16);
+    bytes[2] = (unsigned char)(value >> 8);
+    bytes[3] = (unsigned char)value;
+}
+
+// Length, type, data and the CRC over type and data
+static bool WritePngChunk(FILE *file, const char *type, const unsigned char *data, size_t length) {
+    unsigned char header[8];
+    PutBigEndian32(header, (uint32_t)length);
+    memcpy(header + 4, type, 4);
+
+    // ComputeCRC32 takes one buffer, so the type is checksummed from a copy with the data behind it
+    unsigned char *typed = malloc(length + 4);
+    if (typed == NULL) return false;
+    memcpy(typed, type, 4);
+    if (length > 0) memcpy(typed + 4, data, length);
+    unsigned char crc[4];
+    PutBigEndian32(crc, ComputeCRC32(typed, (int)(length + 4)));
+    free(typed);
+
+    return (fwrite(header, 1, 8, file) == 8) && (length == 0 || fwrite(data, 1, length, file) == length) && (fwrite(crc, 1, 4, file) == 4);
+}
+
+static uint32_t ComputeAdler32(const unsigned char *data, size_t length) {
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < length; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+// Encodes the PNG here rather than through ExportImage(), whose file extension check goes through raylib's
+// static text buffers and so races between workers. CompressData() and ComputeCRC32() keep no shared state.
+static bool WritePngFrame(Capture *capture, const CaptureSlot *slot) {
+    int width = capture->width, height = capture->height;
+    size_t stride = (size_t)width * 4;
+
+    // Filter type 0 on every row: the arena is mostly flat colour, which DEFLATE already does well on
+    for (int y = 0; y < height; y++) {
+        unsigned char *row = slot->encoded + (size_t)y * (1 + stride);
+        row[0] = 0;
+        memcpy(row + 1, slot->pixels + (size_t)y * stride, stride);
+    }
+    size_t rawSize = GetEncodedSize(CAPTURE_PNG, width, height);
+
+    // IDAT holds a zlib stream: CompressData() gives raw DEFLATE, so add the zlib header and Adler-32 trailer
+    int deflatedSize = 0;
+    unsigned char *deflated = CompressData(slot->encoded, (int)rawSize, &deflatedSize);
+    if (deflated == NULL) return false;
+    unsigned char *zlib = malloc((size_t)deflatedSize + 6);
+    if (zlib == NULL) {
+        MemFree(deflated);
+        return false;
+    }
+    zlib[0] = 0x78; // DEFLATE, 32 KiB window
+    zlib[1] = 0x01; // No preset dictionary; makes the header a multiple of 31
+    memcpy(zlib + 2, deflated, deflatedSize);
+    PutBigEndian32(zlib + 2 + deflatedSize, ComputeAdler32(slot->encoded, rawSize));
+    MemFree(deflated);
+
+    unsigned char header[13];
+    PutBigEndian32(header, (uint32_t)width);
+    PutBigEndian32(header + 4, (uint32_t)height);
+    header[8] = 8; // Bits per channel
+    header[9] = 6; // RGBA
+    header[10] = 0; // Compression, filter and interlace methods
+    header[11] = 0;
+    header[12] = 0;
+
+    char fileName[1024]; // Not TextFormat(), its buffers are shared with the main thread
+    snprintf(fileName, sizeof(fileName), "%s/frame_%06ld.png", capture->path, slot->frame);
+    FILE *file = fopen(fileName, "wb");
+    bool ok = (file != NULL);
+    if (ok) {
+        static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        ok = (fwrite(signature, 1, 8, file) == 8) && WritePngChunk(file, "IHDR", header, sizeof(header)) &&
+            WritePngChunk(file, "IDAT", zlib, (size_t)deflatedSize + 6) && WritePngChunk(file, "IEND", NULL, 0);
+        ok &= (fclose(file) == 0);
+    }
+    free(zlib);
+    return ok;
+}
+
+static void *RunCaptureWorker(void *argument) {
+    Capture *capture = (Capture *)argument;
+
+    for (;;) {
+        pthread_mutex_lock(&capture->lock);
+        while (capture->queueCount == 0 && !capture->stopping) pthread_cond_wait(&capture->queued, &capture->lock);
+        if (capture->queueCount == 0) { // Stopping and drained
+            pthread_mutex_unlock(&capture->lock);
+            return NULL;
+        }
+        int index = capture->queue[capture->queueHead];
+        capture->queueHead = (capture->queueHead + 1) % CAPTURE_POOL_FRAMES;
+        capture->queueCount--;
+        pthread_mutex_unlock(&capture->lock);
+
+        CaptureSlot *slot = &capture->slots[index];
+        bool ok;
+        if (capture->format == CAPTURE_Y4M) {
+            ConvertToI420(slot, capture->width, capture->height);
+
+            // Frames leave the queue in order, so whichever frame is due is always held by a running worker
+            pthread_mutex_lock(&capture->lock);
+            while (capture->nextWrite != slot->frame) pthread_cond_wait(&capture->frameWritten, &capture->lock);
+            pthread_mutex_unlock(&capture->lock);
+
+            ok = WriteY4MFrame(capture, slot);
+        }
+        else ok = WritePngFrame(capture, slot);
+
+        pthread_mutex_lock(&capture->lock);
+        if (ok) capture->written++;
+        else capture->failed++;
+        if (capture->format == CAPTURE_Y4M) {
+            capture->nextWrite++;
+            pthread_cond_broadcast(&capture->frameWritten);
+        }
+        capture->freeSlots[capture->freeCount++] = index;
+        pthread_mutex_unlock(&capture->lock);
+    }
+}
+
+//
+/* Lifetime */
+//
+static void FreeCaptureSlots(Capture *capture) {
+    for (int i = 0; i < CAPTURE_POOL_FRAMES; i++) {
+        free(capture->slots[i].pixels);
+        free(capture->slots[i].encoded);
+    }
+}
+
+bool InitCapture(Capture *capture, CaptureFormat format, const char *path, int width, int height, int fps) {
+    memset(capture, 0, sizeof(Capture));
+    capture->format = format;
+    capture->path = path;
+    capture->width = width;
+    capture->height = height;
+
+    // I420 halves both chroma dimensions
+    if (format == CAPTURE_Y4M && ((width % 2) != 0 || (height % 2) != 0)) {
+        TraceLog(LOG_WARNING, "CAPTURE: Y4M needs an even frame size, got %ix%i", width, height);
+        return false;
+    }
+
+    // The whole pool up front: capture memory is fixed however far encoding falls behind
+    for (int i = 0; i < CAPTURE_POOL_FRAMES; i++) {
+        capture->slots[i].pixels = malloc((size_t)width * height * 4);
+        capture->slots[i].encoded = malloc(GetEncodedSize(format, width, height));
+        if (capture->slots[i].pixels == NULL || capture->slots[i].encoded == NULL) {
+            FreeCaptureSlots(capture);
+            return false;
+        }
+        capture->freeSlots[capture->freeCount++] = i;
+    }
+
+    if (format == CAPTURE_Y4M) {
+        capture->stream = fopen(path, "wb");
+        if (capture->stream == NULL || fprintf(capture->stream, "YUV4MPEG2 W%i H%i F%i:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n", width, height, fps) < 0) {
+            TraceLog(LOG_WARNING, "CAPTURE: [%s] Failed to open stream", path);
+            if (capture->stream != NULL) fclose(capture->stream);
+            FreeCaptureSlots(capture);
+            return false;
+        }
+    }
+    else if (!DirectoryExists(path) && MakeDirectory(path) != 0) {
+        TraceLog(LOG_WARNING, "CAPTURE: [%s] Failed to create directory", path);
+        FreeCaptureSlots(capture);
+        return false;
+    }
+
+    pthread_mutex_init(&capture->lock, NULL);
+    pthread_cond_init(&capture->queued, NULL);
+    pthread_cond_init(&capture->frameWritten, NULL);
+    for (int i = 0; i < CAPTURE_WORKERS; i++) {
+        if (pthread_create(&capture->workers[i], NULL, RunCaptureWorker, capture) != 0) break;
+        capture->workerCount++;
+    }
+    if (capture->workerCount == 0) {
+        TraceLog(LOG_WARNING, "CAPTURE: Failed to start any worker");
+        pthread_cond_destroy(&capture->frameWritten);
+        pthread_cond_destroy(&capture->queued);
+        pthread_mutex_destroy(&capture->lock);
+        if (capture->stream != NULL) fclose(capture->stream);
+        FreeCaptureSlots(capture);
+        return false;
+    }
+
+    capture->active = true;
+    TraceLog(LOG_INFO, "CAPTURE: [%s] %ix%i %s, %i buffers, %i workers", path, width, height,
+        (format == CAPTURE_Y4M) ? "Y4M" : "PNG", CAPTURE_POOL_FRAMES, capture->workerCount);
+    return true;
+}
+
+void UnloadCapture(Capture *capture) {
+    if (!capture->active) return;
+
+    pthread_mutex_lock(&capture->lock);
+    capture->stopping = true;
+    pthread_cond_broadcast(&capture->queued);
+    pthread_mutex_unlock(&capture->lock);
+    for (int i = 0; i < capture->workerCount; i++) pthread_join(capture->workers[i], NULL);
+
+    if (capture->stream != NULL && fclose(capture->stream) != 0) TraceLog(LOG_WARNING, "CAPTURE: [%s] Failed to close stream", capture->path);
+    TraceLog(LOG_INFO, "CAPTURE: [%s] %ld frames written, %ld dropped, %ld failed", capture->path,
+        capture->written, capture->dropped, capture->failed);
+
+    pthread_cond_destroy(&capture->frameWritten);
+    pthread_cond_destroy(&capture->queued);
+    pthread_mutex_destroy(&capture->lock);
+    FreeCaptureSlots(capture);
+    memset(capture, 0, sizeof(Capture));
+}
+
+//
+/* Main thread: copy the frame into a free slot and queue it, or drop it */
+//
+bool CaptureFrame(Capture *capture) {
+    if (!capture->active) return false;
+
+    pthread_mutex_lock(&capture->lock);
+    if (capture->freeCount == 0) {
+        capture->dropped++;
+        pthread_mutex_unlock(&capture->lock);
+        return false;
+    }
+    int index = capture->freeSlots[--capture->freeCount];
+    pthread_mutex_unlock(&capture->lock);
+
+    // Synchronous readback: rlgl exposes no pixel buffer objects to read into asynchronously
+    unsigned char *pixels = rlReadScreenPixels(capture->width, capture->height);
+    CaptureSlot *slot = &capture->slots[index];
+    bool ok = (pixels != NULL);
+    if (ok) {
+        memcpy(slot->pixels, pixels, (size_t)capture->width * capture->height * 4);
+        free(pixels);
+    }
+
+    pthread_mutex_lock(&capture->lock);
+    if (ok) {
+        slot->frame = capture->accepted++;
+        capture->queue[(capture->queueHead + capture->queueCount) % CAPTURE_POOL_FRAMES] = index;
+        capture->queueCount++;
+        pthread_cond_signal(&capture->queued);
+    }
+    else {
+        capture->failed++;
+        capture->freeSlots[capture->freeCount++] = index;
+    }
+    pthread_mutex_unlock(&capture->lock);
+    return ok;
+}
@@ -0,0 +1,289 @@
+#include "draw.h"
+#include "globals.h"
+#include "profiler.h"
+#include "render.h"
+#include "rlgl.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+void DrawLogo() {
+    ClearBackground(m_colors[COLOR_DARK_GRAY]);
+    DrawText("My Game Logo", GetScreenWidth() / 2 - MeasureText("My Game Logo", 20) / 2, GetScreenHeight() / 2 - 10, 20, m_colors[COLOR_WHITE]);
+    DrawText("Created by Your Name", GetScreenWidth() / 2 - MeasureText("Created by Your Name", 20) / 2, GetScreenHeight() / 2 + 20, 20, m_colors[COLOR_WHITE]);
+}
+
+void DrawMainMenu() {
+    ClearBackground(m_colors[COLOR_DARK_GRAY]);
+    DrawText("Main Menu", GetScreenWidth() / 2 - MeasureText("Main Menu", 40) / 2, GetScreenHeight() / 2 - 40, 40, m_colors[COLOR_WHITE]);
+    DrawText("1. Play Game", GetScreenWidth() / 2 - MeasureText("1. Play Game", 20) / 2, GetScreenHeight() / 2, 20, m_colors[COLOR_WHITE]);
+    DrawText("2. Settings", GetScreenWidth() / 2 - MeasureText("2. Settings", 20) / 2, GetScreenHeight() / 2 + 30, 20, m_colors[COLOR_WHITE]);
+    DrawText("3. Exit", GetScreenWidth() / 2 - MeasureText("3. Exit", 20) / 2, GetScreenHeight() / 2 + 60, 20, m_colors[COLOR_WHITE]);
+}
+
+// Centre on the target, but stop at the arena edges; an arena smaller than the window stays centred
+Camera2D GetGameCamera(float arenaWidth, float arenaHeight, Vector2 target) {
+    float halfWidth = GetScreenWidth() * 0.5f;
+    float halfHeight = GetScreenHeight() * 0.5f;
+
+    Camera2D camera = { 0 };
+    camera.offset = (Vector2){ halfWidth, halfHeight };
+    camera.target.x = (arenaWidth > 2.0f * halfWidth) ? Clamp(target.x, halfWidth, arenaWidth - halfWidth) : arenaWidth * 0.5f;
+    camera.target.y = (arenaHeight > 2.0f * halfHeight) ? Clamp(target.y, halfHeight, arenaHeight - halfHeight) : arenaHeight * 0.5f;
+    camera.zoom = 1.0f;
+    return camera;
+}
+
+// World-space rectangle the camera shows
+Rectangle GetCameraView(Camera2D camera) {
+    float width = GetScreenWidth() / camera.zoom;
+    float height = GetScreenHeight() / camera.zoom;
+    return (Rectangle){ camera.target.x - camera.offset.x / camera.zoom, camera.target.y - camera.offset.y / camera.zoom, width, height };
+}
+
+// Arena border and a coarse floor grid, so scrolling is visible; only the lines inside the view are drawn
+void DrawArena(float arenaWidth, float arenaHeight, Rectangle view) {
+    const float spacing = 160.0f;
+    float top = fmaxf(view.y, 0.0f), bottom = fminf(view.y + view.height, arenaHeight);
+    float left = fmaxf(view.x, 0.0f), right = fminf(view.x + view.width, arenaWidth);
+
+    for (float x = ceilf(left / spacing) * spacing; x <= right; x += spacing) {
+        DrawLineV((Vector2){ x, top }, (Vector2){ x, bottom }, m_colors[COLOR_GRAY]);
+    }
+    for (float y = ceilf(top / spacing) * spacing; y <= bottom; y += spacing) {
+        DrawLineV((Vector2){ left, y }, (Vector2){ right, y }, m_colors[COLOR_GRAY]);
+    }
+    DrawRectangleLinesEx((Rectangle){ 0.0f, 0.0f, arenaWidth, arenaHeight }, 4.0f, m_colors[COLOR_LIGHT_GRAY]);
+}
+
+void DrawGame(const GameView *game, Hud *hud) {
+    // Before anything else, so re-rendering the HUD texture has an empty batch to flush
+    BeginRenderSection(RENDER_SECTION_HUD);
+    UpdateHud(hud, game->playerHealth, game->wave, (int)(WAVE_DURATION - game->waveTimer), game->enemiesShot);
+
+    ClearBackground(m_colors[COLOR_DARK_GRAY]);
+
+    // Entities are drawn between their last two ticks, so motion stays smooth at any frame rate
+    Vector2 playerPosition = Vector2Lerp(game->playerPreviousPosition, game->playerPosition, game->renderAlpha);
+
+    // The world scrolls under a camera following the player; whatever the view can't see is culled
+    Camera2D camera = GetGameCamera((float)game->arenaWidth, (float)game->arenaHeight, playerPosition);
+    Rectangle view = GetCameraView(camera);
+    BeginRenderSection(RENDER_SECTION_ARENA);
+    BeginMode2D(camera);
+    DrawArena((float)game->arenaWidth, (float)game->arenaHeight, view);
+
+    ResetCircleDrawStats();
+    SetCircleCullRect(view);
+    SetCircleZoom(camera.zoom);
+    BeginCircles();
+    DrawCircleBatched(playerPosition, game->playerRadius, m_colors[COLOR_BLUE]);
+
+    // Draw power-ups
+    for (int i = 0; i < game->powerUpCount; i++) {
+        DrawCircleBatched(game->powerUps[i].position, game->powerUps[i].radius, m_colors[COLOR_GREEN]); // Draw power-up
+    }
+    EndCircles();
+
+    BeginRenderSection(RENDER_SECTION_ENEMIES);
+    DrawEnemies(game);
+    BeginRenderSection(RENDER_SECTION_PARTICLES);
+    DrawParticles(game);
+    BeginRenderSection(RENDER_SECTION_BULLETS);
+    DrawBullets(game);
+    ClearCircleCullRect();
+    CircleDrawStats circleStats = GetCircleDrawStats();
+    FlushRenderBatch(); // EndMode2D flushes the world anyway; doing it here keeps it in the bullets' section
+    EndMode2D();
+
+    // Health, wave, time left and kills, laid out only when one of them changed
+    BeginRenderSection(RENDER_SECTION_HUD);
+    DrawHud(hud);
+
+    // Numbers from the last complete frame, this one is still being submitted
+    BeginRenderSection(RENDER_SECTION_TEXT);
+    const RenderBatchStats *batch = &GetRenderFrameStats()->total;
+    DrawDebugText(12,
+        game->enemyCount, "Enemy Count",
+        game->particleCount, "Particles",
+        game->powerUpsCollected, "PowerUps Collected",
+        (int)GetCirclePath(), "Circle Path (F4)",
+        circleStats.culled, "Circles Culled",
+        circleStats.impostors, "Circle Impostors",
+        circleStats.vertices, "Circle Vertices",
+        circleStats.flushes, "Circle Flushes",
+        batch->drawCalls, "Draw Calls",
+        batch->vertices, "Vertices",
+        batch->flushes, "Batch Flushes",
+        batch->textureSwitches, "Texture Switches"
+    );
+#ifdef PROFILER_ENABLED
+    DrawProfilerOverlay(10, 70 + 20 * 13 + 10);
+#endif
+}
+
+void DrawDebugText(int count, ...) {
+    va_list args;
+    va_start(args, count);
+
+    int x = 10;
+    int y = 70; //starting Y position
+    int fontSize = 16;
+
+    DrawText("[debug]", x, y, fontSize, m_colors[COLOR_WHITE]);
+    for (int i = 0; i < count; i++) {
+        y += 20;
+        int param = va_arg(args, int);
+        const char *string = va_arg(args, const char*);
+        char text[64];
+        sprintf(text, "%s: %d", string, param); // format the text
+        DrawText(text, x, y, fontSize, m_colors[COLOR_WHITE]);
+    }
+    va_end(args);
+}
+
+// Frame time sparkline over the last few seconds, with the 60 FPS line and this wave's percentiles
+void DrawTelemetryOverlay(const Telemetry *telemetry, int x, int y) {
+    const int height = 50;
+    const float scaleMs = 33.3f; // Top of the plot is two 60 FPS frames
+
+    DrawRectangle(x, y, TELEMETRY_SPARKLINE_FRAMES, height, Fade(m_colors[COLOR_GRAY], 0.6f));
+    int budgetY = y + height - (int)(16.7f / scaleMs * height);
+    DrawLine(x, budgetY, x + TELEMETRY_SPARKLINE_FRAMES, budgetY, m_colors[COLOR_LIGHTER_GRAY]);
+
+    // Oldest sample on the left; the ring's next slot is the oldest
+    for (int i = 1; i < TELEMETRY_SPARKLINE_FRAMES; i++) {
+        float previous = telemetry->sparkline[(telemetry->sparklineNext + i - 1) % TELEMETRY_SPARKLINE_FRAMES];
+        float current = telemetry->sparkline[(telemetry->sparklineNext + i) % TELEMETRY_SPARKLINE_FRAMES];
+        if (previous > scaleMs) previous = scaleMs;
+        if (current > scaleMs) current = scaleMs;
+        DrawLine(x + i - 1, y + height - (int)(previous / scaleMs * height), x + i, y + height - (int)(current / scaleMs * height),
+            (current > 16.7f) ? m_colors[COLOR_ORANGE_RED] : m_colors[COLOR_GREEN]);
+    }
+
+    const Histogram *frames = &telemetry->histograms[TELEMETRY_FRAME];
+    char text[64];
+    sprintf(text, "p50 %.1f  p99 %.1f  max %.1f ms",
+        GetHistogramPercentile(frames, 50.0) / 1000.0f, GetHistogramPercentile(frames, 99.0) / 1000.0f, frames->maxUs / 1000.0f);
+    DrawText(text, x, y + height + 4, 10, m_colors[COLOR_WHITE]);
+}
+
+// Last frame's render batch cost per section, so draw calls and flushes can be pinned on what caused them
+void DrawRenderStatsOverlay(int x, int y) {
+    const RenderFrameStats *stats = GetRenderFrameStats();
+    char text[96];
+
+    sprintf(text, "calls / vertices / flushes / switches, peak %d of %d draws", stats->peakDraws, RL_DEFAULT_BATCH_DRAWCALLS);
+    DrawText(text, x, y, 10, m_colors[COLOR_WHITE]);
+    for (int i = 0; i < RENDER_SECTION_COUNT; i++) {
+        const RenderBatchStats *section = &stats->sections[i];
+        sprintf(text, "%s: %d / %d / %d / %d", RenderSectionToString((RenderSection)i), section->drawCalls, section->vertices, section->flushes, section->textureSwitches);
+        DrawText(text, x, y + 14 * (i + 1), 10, m_colors[COLOR_WHITE]);
+    }
+}
+
+#ifdef PROFILER_ENABLED
+// Recent frames as stacked bars, one column per frame and one colour per phase, newest on the right
+void DrawProfilerOverlay(int x, int y) {
+    static const int phaseColors[PROFILE_PHASE_COUNT] = {
+        COLOR_LIGHT_BLUE, COLOR_LIGHT_YELLOW, COLOR_ORANGE_RED, COLOR_PINK, COLOR_YELLOW,
+        COLOR_RED, COLOR_GREEN, COLOR_ORANGE, COLOR_DARK_GREEN, COLOR_LIGHTER_GRAY, COLOR_BLUE
+    };
+    const int frames = 120;
+    const int barWidth = 2;
+    const int height = 60;
+    const float budgetUs = 1e6f / 60.0f; // A full-height bar is one 60 FPS frame
+    static ProfileFrame frame;
+
+    DrawRectangle(x, y, frames * barWidth, height, Fade(m_colors[COLOR_GRAY], 0.6f));
+    for (int age = 0; age < frames; age++) {
+        if (!ProfilerReadFrame(age, &frame)) break;
+
+        int column = x + (frames - 1 - age) * barWidth;
+        float bottom = (float)(y + height);
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            float barHeight = frame.phaseUs[phase] / budgetUs * height;
+            if (bottom - barHeight < y) barHeight = bottom - y; // Clip over-budget frames at the top
+            DrawRectangle(column, (int)(bottom - barHeight), barWidth, (int)ceilf(barHeight), m_colors[phaseColors[phase]]);
+            bottom -= barHeight;
+        }
+    }
+
+    // Legend with the latest frame's time per phase
+    if (ProfilerReadFrame(0, &frame)) {
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            char text[48];
+            sprintf(text, "%s %.2f ms", ProfilePhaseToString(phase), frame.phaseUs[phase] / 1000.0f);
+            int row = y + height + 4 + (phase / 2) * 14;
+            int column = x + (phase % 2) * 130;
+            DrawRectangle(column, row + 2, 8, 8, m_colors[phaseColors[phase]]);
+            DrawText(text, column + 12, row, 10, m_colors[COLOR_WHITE]);
+        }
+    }
+}
+#endif
+
+// Populations go through a circle list, so the renderer picks LOD for them in bulk
+void DrawBullets(const GameView *view) {
+    CircleList *list = BeginCircleList(view->bulletCount);
+    if (list == NULL) return;
+
+    for (int i = 0; i < view->bulletCount; i++) {
+        const Bullet *bullet = &view->bullets[i];
+        if (bullet->active) {
+            list->center[list->count] = Vector2Lerp(bullet->previousPosition, bullet->position, view->renderAlpha);
+            list->radius[list->count] = bullet->radius;
+            list->color[list->count] = m_colors[COLOR_LIGHT_YELLOW];
+            list->count++;
+        }
+    }
+
+    BeginCircles();
+    DrawCircleList(list);
+    EndCircles();
+}
+
+void DrawEnemies(const GameView *view) {
+    CircleList *list = BeginCircleList(view->enemyCount);
+    if (list == NULL) return;
+
+    float alpha = view->renderAlpha;
+    for (int i = 0; i < view->enemyCount; i++) {
+        list->center[i] = (Vector2){
+            view->enemyPreviousX[i] + (view->enemyX[i] - view->enemyPreviousX[i]) * alpha,
+            view->enemyPreviousY[i] + (view->enemyY[i] - view->enemyPreviousY[i]) * alpha
+        };
+        list->radius[i] = view->enemyRadius[i];
+        list->color[i] = m_colors[COLOR_ORANGE_RED];
+    }
+    list->count = view->enemyCount;
+
+    BeginCircles();
+    DrawCircleList(list);
+    EndCircles();
+}
+
+// Each particle is drawn backed off along its velocity by the part of the tick not yet simulated, and
+// shrinks and fades with its remaining life
+void DrawParticles(const GameView *view) {
+    CircleList *list = BeginCircleList(view->particleCount);
+    if (list == NULL) return;
+
+    float behind = (1.0f - view->renderAlpha) * FIXED_TIMESTEP;
+    for (int i = 0; i < view->particleCount; i++) {
+        float life = view->particleLife[i];
+        list->center[i] = (Vector2){ view->particleX[i] - view->particleVX[i] * behind, view->particleY[i] - view->particleVY[i] * behind };
+        list->radius[i] = PARTICLE_RADIUS * life;
+        list->color[i] = Fade(view->particleColor[i], life);
+    }
+    list->count = view->particleCount;
+
+    BeginCircles();
+    DrawCircleList(list);
+    EndCircles();
+}
+
+void DrawGameOver() {
+    ClearBackground(m_colors[COLOR_DARK_GRAY]);
+    DrawText("Game Over", GetScreenWidth() / 2 - MeasureText("Game Over", 40) / 2, GetScreenHeight() / 2 - 40, 40, m_colors[COLOR_WHITE]);
+    DrawText("Press R to Restart or M to go to Main Menu", GetScreenWidth() / 2 - MeasureText("Press R to Restart or M to go to Main Menu", 20) / 2, GetScreenHeight() / 2, 20, DARKGRAY);
+}
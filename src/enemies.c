@@ -0,0 +1,388 @@
+#include "enemies.h"
+#include <math.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define ENEMY_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+static EnemyKernel activeKernel = ENEMY_KERNEL_AUTO;
+
+// Every per-enemy array, so reserve, commit and release stay in lockstep
+typedef struct {
+    void **data;
+    size_t elementSize;
+} EnemyArray;
+
+#define ENEMY_ARRAY_COUNT 8
+
+static void GetEnemyArrays(Enemies *enemies, EnemyArray *arrays) {
+    arrays[0] = (EnemyArray){ (void **)&enemies->x, sizeof(float) };
+    arrays[1] = (EnemyArray){ (void **)&enemies->y, sizeof(float) };
+    arrays[2] = (EnemyArray){ (void **)&enemies->radius, sizeof(float) };
+    arrays[3] = (EnemyArray){ (void **)&enemies->flags, sizeof(unsigned char) };
+    arrays[4] = (EnemyArray){ (void **)&enemies->pushX, sizeof(float) };
+    arrays[5] = (EnemyArray){ (void **)&enemies->pushY, sizeof(float) };
+    arrays[6] = (EnemyArray){ (void **)&enemies->previousX, sizeof(float) };
+    arrays[7] = (EnemyArray){ (void **)&enemies->previousY, sizeof(float) };
+}
+
+void InitEnemies(Enemies *enemies, const PoolConfig *config) {
+    EnemyArray arrays[ENEMY_ARRAY_COUNT];
+    GetEnemyArrays(enemies, arrays);
+
+    int maxCapacity = config->maxCapacity;
+    enemies->config = *config;
+    for (int i = 0; i < ENEMY_ARRAY_COUNT; i++) {
+        *arrays[i].data = ReservePoolMemory(maxCapacity * arrays[i].elementSize);
+    }
+    InitSlotMap(&enemies->slots, 0, maxCapacity);
+
+    int capacity = (config->initialCapacity < maxCapacity) ? config->initialCapacity : maxCapacity;
+    while (enemies->slots.capacity < capacity && GrowEnemies(enemies)) { }
+}
+
+bool GrowEnemies(Enemies *enemies) {
+    EnemyArray arrays[ENEMY_ARRAY_COUNT];
+    GetEnemyArrays(enemies, arrays);
+
+    int oldCapacity = enemies->slots.capacity;
+    int capacity = NextPoolCapacity(oldCapacity, &enemies->config);
+    if (capacity == oldCapacity) return false; // Hard ceiling reached
+
+    for (int i = 0; i < ENEMY_ARRAY_COUNT; i++) {
+        if (*arrays[i].data == NULL) return false;
+        if (!CommitPoolMemory(*arrays[i].data, oldCapacity * arrays[i].elementSize, capacity * arrays[i].elementSize)) return false;
+    }
+
+    return GrowSlotMap(&enemies->slots, capacity);
+}
+
+void UnloadEnemies(Enemies *enemies) {
+    EnemyArray arrays[ENEMY_ARRAY_COUNT];
+    GetEnemyArrays(enemies, arrays);
+
+    int maxCapacity = enemies->slots.maxCapacity;
+    int capacity = enemies->slots.capacity;
+    for (int i = 0; i < ENEMY_ARRAY_COUNT; i++) {
+        ReleasePoolMemory(*arrays[i].data, maxCapacity * arrays[i].elementSize, capacity * arrays[i].elementSize);
+        *arrays[i].data = NULL;
+    }
+    UnloadSlotMap(&enemies->slots);
+}
+
+void ClearEnemies(Enemies *enemies) {
+    ClearSlotMap(&enemies->slots);
+}
+
+Handle AddEnemy(Enemies *enemies, float x, float y, float radius) {
+    if (enemies->slots.count >= enemies->slots.capacity && !GrowEnemies(enemies)) return NULL_HANDLE;
+
+    Handle handle = SlotMapInsert(&enemies->slots);
+    if (handle.generation == 0) return handle; // Pool is full
+
+    int index = enemies->slots.count - 1;
+    enemies->x[index] = x;
+    enemies->y[index] = y;
+    enemies->radius[index] = radius;
+    enemies->flags[index] = 0;
+    enemies->previousX[index] = x;
+    enemies->previousY[index] = y;
+    return handle;
+}
+
+void RemoveEnemy(Enemies *enemies, int index) {
+    int moved = SlotMapRemove(&enemies->slots, index);
+    if (moved >= 0) {
+        enemies->x[index] = enemies->x[moved];
+        enemies->y[index] = enemies->y[moved];
+        enemies->radius[index] = enemies->radius[moved];
+        enemies->flags[index] = enemies->flags[moved];
+        enemies->previousX[index] = enemies->previousX[moved];
+        enemies->previousY[index] = enemies->previousY[moved];
+    }
+}
+
+void SaveEnemyPositions(Enemies *enemies) {
+    memcpy(enemies->previousX, enemies->x, enemies->slots.count * sizeof(float));
+    memcpy(enemies->previousY, enemies->y, enemies->slots.count * sizeof(float));
+}
+
+int RemoveFlaggedEnemies(Enemies *enemies, unsigned char flag) {
+    int removed = 0;
+    for (int i = 0; i < enemies->slots.count; ) {
+        if (enemies->flags[i] & flag) {
+            RemoveEnemy(enemies, i); // Re-test index i, it now holds the former last enemy
+            removed++;
+        }
+        else i++;
+    }
+    return removed;
+}
+
+//
+/* Crowd separation: Jacobi-style positional constraint, pushes are gathered from old positions and applied together. */
+//
+void SeparateEnemies(Enemies *enemies, SpatialGrid *grid, float arenaWidth, float arenaHeight, int iterations) {
+    int count = enemies->slots.count;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        BuildSpatialGrid(grid, enemies->x, enemies->y, enemies->radius, count);
+        const float *sortedX = grid->sortedX;
+        const float *sortedY = grid->sortedY;
+        const float *sortedRadius = grid->sortedRadius;
+
+        for (int a = 0; a < count; a++) {
+            enemies->pushX[a] = 0.0f;
+            enemies->pushY[a] = 0.0f;
+        }
+
+        // Walk enemies in cell order so neighbour cells stay in cache. Each overlapping pair is resolved once,
+        // from its lower sorted index, and both sides get half the push; pushes are stored in sorted order.
+        for (int a = 0; a < count; a++) {
+            float x = sortedX[a];
+            float y = sortedY[a];
+            float radius = sortedRadius[a];
+            float reach = radius + grid->maxRadius;
+            float pushX = 0.0f;
+            float pushY = 0.0f;
+            int neighbours = 0;
+
+            int column0, row0, column1, row1;
+            GetSpatialGridRange(grid, x - reach, y - reach, x + reach, y + reach, &column0, &row0, &column1, &row1);
+            for (int row = row0; row <= row1 && neighbours < SEPARATION_MAX_NEIGHBOURS; row++) {
+                int rowStart = grid->cellStart[row * grid->columns + column0];
+                int rowEnd = grid->cellStart[row * grid->columns + column1 + 1]; // Cells of a row are contiguous
+                if (rowStart <= a) rowStart = a + 1;
+                for (int b = rowStart; b < rowEnd; b++) {
+                    float dx = x - sortedX[b];
+                    float dy = y - sortedY[b];
+                    float minDistance = radius + sortedRadius[b];
+                    float distanceSq = dx*dx + dy*dy;
+                    if (distanceSq >= minDistance*minDistance) continue;
+
+                    // Coincident enemies split along x by index
+                    float distance = sqrtf(distanceSq);
+                    float overlap = 0.5f * SEPARATION_RELAXATION * (minDistance - distance);
+                    float stepX, stepY;
+                    if (distance > 0.0f) {
+                        float scale = overlap / distance;
+                        stepX = dx * scale;
+                        stepY = dy * scale;
+                    }
+                    else {
+                        stepX = (grid->items[a] < grid->items[b]) ? -overlap : overlap;
+                        stepY = 0.0f;
+                    }
+                    pushX += stepX;
+                    pushY += stepY;
+                    enemies->pushX[b] -= stepX;
+                    enemies->pushY[b] -= stepY;
+
+                    if (++neighbours >= SEPARATION_MAX_NEIGHBOURS) break;
+                }
+            }
+            enemies->pushX[a] += pushX;
+            enemies->pushY[a] += pushY;
+        }
+
+        // Apply and keep everyone inside the arena
+        for (int a = 0; a < count; a++) {
+            int i = grid->items[a];
+            float radius = sortedRadius[a];
+            float x = sortedX[a] + enemies->pushX[a];
+            float y = sortedY[a] + enemies->pushY[a];
+            x = (x < radius) ? radius : x;
+            if (x > arenaWidth - radius) x = arenaWidth - radius;
+            y = (y < radius) ? radius : y;
+            if (y > arenaHeight - radius) y = arenaHeight - radius;
+            enemies->x[i] = x;
+            enemies->y[i] = y;
+        }
+    }
+}
+
+//
+/* Update kernels: every path performs the same IEEE operations in the same order, so results are bit-identical. */
+//
+static int SeekEnemiesScalar(Enemies *enemies, int start, int end, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime) {
+    int hits = 0;
+    for (int i = start; i < end; i++) {
+        // Direction from enemy to player, normalized
+        float dx = playerX - enemies->x[i];
+        float dy = playerY - enemies->y[i];
+        float length = sqrtf(dx*dx + dy*dy);
+        float invLength = (length > 0.0f) ? 1.0f / length : 0.0f;
+        dx = dx * invLength;
+        dy = dy * invLength;
+
+        // Move towards the player and clamp to the arena
+        float radius = enemies->radius[i];
+        float x = enemies->x[i] + dx * ENEMY_SPEED * deltaTime;
+        float y = enemies->y[i] + dy * ENEMY_SPEED * deltaTime;
+        x = (x < radius) ? radius : x;
+        if (x > arenaWidth - radius) x = arenaWidth - radius;
+        y = (y < radius) ? radius : y;
+        if (y > arenaHeight - radius) y = arenaHeight - radius;
+        enemies->x[i] = x;
+        enemies->y[i] = y;
+
+        // Circle overlap with the player
+        float hx = x - playerX;
+        float hy = y - playerY;
+        float reach = playerRadius + radius;
+        bool hit = (hx*hx + hy*hy) <= reach*reach;
+        enemies->flags[i] = (enemies->flags[i] & ~ENEMY_FLAG_HIT_PLAYER) | (hit ? ENEMY_FLAG_HIT_PLAYER : 0);
+        hits += hit;
+    }
+    return hits;
+}
+
+#ifdef ENEMY_KERNEL_X86
+static int StoreHitFlags(Enemies *enemies, int index, int mask, int lanes) {
+    int hits = 0;
+    for (int lane = 0; lane < lanes; lane++) {
+        int hit = (mask >> lane) & 1;
+        enemies->flags[index + lane] = (enemies->flags[index + lane] & ~ENEMY_FLAG_HIT_PLAYER) | (hit ? ENEMY_FLAG_HIT_PLAYER : 0);
+        hits += hit;
+    }
+    return hits;
+}
+
+static int SeekEnemiesSSE2(Enemies *enemies, int start, int end, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime) {
+    const __m128 px = _mm_set1_ps(playerX);
+    const __m128 py = _mm_set1_ps(playerY);
+    const __m128 pr = _mm_set1_ps(playerRadius);
+    const __m128 w = _mm_set1_ps(arenaWidth);
+    const __m128 h = _mm_set1_ps(arenaHeight);
+    const __m128 speed = _mm_set1_ps(ENEMY_SPEED);
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    int hits = 0;
+    int i = start;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(&enemies->x[i]);
+        __m128 y = _mm_loadu_ps(&enemies->y[i]);
+        __m128 radius = _mm_loadu_ps(&enemies->radius[i]);
+
+        __m128 dx = _mm_sub_ps(px, x);
+        __m128 dy = _mm_sub_ps(py, y);
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 invLength = _mm_and_ps(_mm_cmpgt_ps(length, zero), _mm_div_ps(one, length));
+        dx = _mm_mul_ps(dx, invLength);
+        dy = _mm_mul_ps(dy, invLength);
+
+        x = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(dx, speed), dt));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(dy, speed), dt));
+        x = _mm_min_ps(_mm_max_ps(x, radius), _mm_sub_ps(w, radius));
+        y = _mm_min_ps(_mm_max_ps(y, radius), _mm_sub_ps(h, radius));
+        _mm_storeu_ps(&enemies->x[i], x);
+        _mm_storeu_ps(&enemies->y[i], y);
+
+        __m128 hx = _mm_sub_ps(x, px);
+        __m128 hy = _mm_sub_ps(y, py);
+        __m128 reach = _mm_add_ps(pr, radius);
+        __m128 hit = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(hx, hx), _mm_mul_ps(hy, hy)), _mm_mul_ps(reach, reach));
+        hits += StoreHitFlags(enemies, i, _mm_movemask_ps(hit), 4);
+    }
+
+    return hits + SeekEnemiesScalar(enemies, i, end, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+}
+
+__attribute__((target("avx2")))
+static int SeekEnemiesAVX2(Enemies *enemies, int start, int end, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime) {
+    const __m256 px = _mm256_set1_ps(playerX);
+    const __m256 py = _mm256_set1_ps(playerY);
+    const __m256 pr = _mm256_set1_ps(playerRadius);
+    const __m256 w = _mm256_set1_ps(arenaWidth);
+    const __m256 h = _mm256_set1_ps(arenaHeight);
+    const __m256 speed = _mm256_set1_ps(ENEMY_SPEED);
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    int hits = 0;
+    int i = start;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&enemies->x[i]);
+        __m256 y = _mm256_loadu_ps(&enemies->y[i]);
+        __m256 radius = _mm256_loadu_ps(&enemies->radius[i]);
+
+        __m256 dx = _mm256_sub_ps(px, x);
+        __m256 dy = _mm256_sub_ps(py, y);
+        __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 invLength = _mm256_and_ps(_mm256_cmp_ps(length, zero, _CMP_GT_OQ), _mm256_div_ps(one, length));
+        dx = _mm256_mul_ps(dx, invLength);
+        dy = _mm256_mul_ps(dy, invLength);
+
+        x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(dx, speed), dt));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_mul_ps(dy, speed), dt));
+        x = _mm256_min_ps(_mm256_max_ps(x, radius), _mm256_sub_ps(w, radius));
+        y = _mm256_min_ps(_mm256_max_ps(y, radius), _mm256_sub_ps(h, radius));
+        _mm256_storeu_ps(&enemies->x[i], x);
+        _mm256_storeu_ps(&enemies->y[i], y);
+
+        __m256 hx = _mm256_sub_ps(x, px);
+        __m256 hy = _mm256_sub_ps(y, py);
+        __m256 reach = _mm256_add_ps(pr, radius);
+        __m256 hit = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(hx, hx), _mm256_mul_ps(hy, hy)), _mm256_mul_ps(reach, reach), _CMP_LE_OQ);
+        hits += StoreHitFlags(enemies, i, _mm256_movemask_ps(hit), 8);
+    }
+
+    return hits + SeekEnemiesScalar(enemies, i, end, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+}
+#endif
+
+static EnemyKernel ResolveEnemyKernel(EnemyKernel kernel) {
+#ifdef ENEMY_KERNEL_X86
+    bool hasAVX2 = __builtin_cpu_supports("avx2");
+    bool hasSSE2 = __builtin_cpu_supports("sse2");
+
+    if (kernel == ENEMY_KERNEL_AUTO) kernel = hasAVX2 ? ENEMY_KERNEL_AVX2 : ENEMY_KERNEL_SSE2;
+    if (kernel == ENEMY_KERNEL_AVX2 && !hasAVX2) kernel = ENEMY_KERNEL_SSE2;
+    if (kernel == ENEMY_KERNEL_SSE2 && !hasSSE2) kernel = ENEMY_KERNEL_SCALAR;
+    return kernel;
+#else
+    (void)kernel;
+    return ENEMY_KERNEL_SCALAR; // No vector paths on this architecture
+#endif
+}
+
+void SetEnemyKernel(EnemyKernel kernel) {
+    activeKernel = ResolveEnemyKernel(kernel);
+}
+
+EnemyKernel GetEnemyKernel(void) {
+    if (activeKernel == ENEMY_KERNEL_AUTO) activeKernel = ResolveEnemyKernel(ENEMY_KERNEL_AUTO);
+    return activeKernel;
+}
+
+const char* EnemyKernelToString(EnemyKernel kernel) {
+    switch (kernel) {
+        case ENEMY_KERNEL_AUTO: return "auto";
+        case ENEMY_KERNEL_SCALAR: return "scalar";
+        case ENEMY_KERNEL_SSE2: return "sse2";
+        case ENEMY_KERNEL_AVX2: return "avx2";
+        default: return "unknown";
+    }
+}
+
+int SeekEnemyRange(Enemies *enemies, int start, int end, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime) {
+    switch (GetEnemyKernel()) {
+#ifdef ENEMY_KERNEL_X86
+        case ENEMY_KERNEL_AVX2:
+            return SeekEnemiesAVX2(enemies, start, end, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+        case ENEMY_KERNEL_SSE2:
+            return SeekEnemiesSSE2(enemies, start, end, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+#endif
+        default:
+            return SeekEnemiesScalar(enemies, start, end, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+    }
+}
+
+int SeekEnemies(Enemies *enemies, float playerX, float playerY, float playerRadius, float arenaWidth, float arenaHeight, float deltaTime) {
+    return SeekEnemyRange(enemies, 0, enemies->slots.count, playerX, playerY, playerRadius, arenaWidth, arenaHeight, deltaTime);
+}
@@ -1,80 +1,158 @@
 #include "game.h"
 #include "globals.h"
-#include <stdarg.h>
+#include "autopilot.h"
+#include "profiler.h"
+#include "jobs.h"
+#include <math.h>
 #include <stdio.h>
 
 
-void InitGameParams(GameLogicParams *params) {
+void InitGameParams(GameLogicParams *params, Platform *platform) {
+    params->platform = platform;
+
     static Player player;
-    InitPlayer(&player);
+    InitPlayer(&player, platform);
     params->player = &player;
 
     static BulletManager bulletManager;
-    InitBulletManager(&bulletManager);
+    InitBulletManager(&bulletManager, &bulletPoolConfig);
     params->bulletManager = &bulletManager;
 
-    static PowerUp powerUp;
-    powerUp.active = false;
+    static PowerUpManager powerUpManager;
+    InitPowerUpManager(&powerUpManager);
 
-    // Initialize enemies array
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        params->enemies[i] = (Enemy){0}; // Initialize each Enemy to zero
-    }
-    static int enemyCount = 0;
-    static int hitEnemyIndex = -1; // Initialize to -1 (no hit)
+    static Particles particles;
+    InitParticles(&particles, PARTICLE_POOL_MAX);
+
+    static Enemies enemies;
+    InitEnemies(&enemies, &enemyPoolConfig);
+
+    static SpatialGrid enemyGrid;
+    InitSpatialGrid(&enemyGrid, ENEMY_GRID_CELL_SIZE);
 
     // Wave system variables
     static float waveTimer = 0.0f;
     static int currentWave = 1;
 
-    params->enemyCount = &enemyCount;
-    params->powerUp = &powerUp;
+    params->enemies = &enemies;
+    params->enemyGrid = &enemyGrid;
+    params->powerUpManager = &powerUpManager;
+    params->particles = &particles;
     params->powerUpsCollected = &powerUpsCollected;
     params->enemiesShot = &enemiesShot;
     params->enemySpawnVar = &enemySpawnVar;
-    params->deltaTime = 0.0f;
+    params->deltaTime = FIXED_TIMESTEP;
+    params->accumulator = 0.0f;
+    params->renderAlpha = 0.0f;
     params->waveTimer = &waveTimer;
     params->currentWave = &currentWave;
-    params->hitEnemyIndex = &hitEnemyIndex;
     params->isGamePaused = false;
+    params->replay = NULL;
+    params->autopilot = NULL;
+    params->useBroadphase = true;
+    params->separationIterations = SEPARATION_ITERATIONS;
+    SeedGameRng(params, GAME_DEFAULT_SEED);
+}
+
+void SeedGameRng(GameLogicParams *params, uint64_t seed) {
+    for (int i = 0; i < GAME_RNG_STREAM_COUNT; i++) {
+        params->rng[i] = RngStream(seed, (uint64_t)i);
+    }
+    params->particles->rng = RngStream(seed, GAME_RNG_STREAM_COUNT + 2); // After the autopilot's stream
+}
+
+// Run as many fixed ticks as the frame time covers; the remainder carries over to the next frame
+int StepGameLogic(GameLogicParams *params, float frameTime) {
+    params->deltaTime = FIXED_TIMESTEP;
+    params->accumulator += frameTime;
+
+    int steps = 0;
+    while (params->accumulator >= FIXED_TIMESTEP && steps < MAX_CATCH_UP_STEPS) {
+        GameLogic(params);
+        PROFILE_TICK();
+        params->accumulator -= FIXED_TIMESTEP;
+        steps++;
+    }
+
+    // Too far behind (slow frame, window drag, breakpoint): drop the backlog rather than spiral
+    if (params->accumulator >= FIXED_TIMESTEP) {
+        params->accumulator = fmodf(params->accumulator, FIXED_TIMESTEP);
+    }
+
+    params->renderAlpha = params->accumulator / FIXED_TIMESTEP;
+    return steps;
 }
 
 void GameLogic(GameLogicParams *params) {
     //
     /* Input Handling: Update player movement based on input. */
     //
-    UpdatePlayer(params->player, params->deltaTime);
+    PROFILE_BEGIN(PROFILE_INPUT);
+    unsigned char input = (params->autopilot != NULL) ? UpdateAutopilot(params->autopilot, params) : ReadPlayerInput(params->platform);
+    if (params->replay != NULL) RecordReplayTick(params->replay, input);
+    UpdatePlayer(params->player, input, params->platform, params->deltaTime);
+    PROFILE_END(PROFILE_INPUT);
 
     //
     /* Update Game State: Update the state of the player, enemies, bullets, and power-ups. */
     //
-    UpdateBullets(params->bulletManager, params->deltaTime);
-    FireBullet(params->player, params->bulletManager, params->enemies, *(params->enemyCount), *(params->powerUpsCollected), 0.05f);
+    PROFILE_BEGIN(PROFILE_BULLETS);
+    UpdateBullets(params->bulletManager, params->platform, params->deltaTime);
+    PROFILE_END(PROFILE_BULLETS);
+
+    PROFILE_BEGIN(PROFILE_ENEMIES);
     UpdateEnemies(params);
-    
+    PROFILE_END(PROFILE_ENEMIES);
+
+    // Age before this tick's emits, so a burst is first drawn where it started
+    PROFILE_BEGIN(PROFILE_PARTICLES);
+    UpdateParticles(params->particles, params->deltaTime);
+    PROFILE_END(PROFILE_PARTICLES);
+
+    // Index enemies once per tick, after they moved; targeting and collisions both query it
+    PROFILE_BEGIN(PROFILE_BROADPHASE);
+    const SpatialGrid *enemyGrid = NULL;
+    if (params->useBroadphase) {
+        BuildSpatialGrid(params->enemyGrid, params->enemies->x, params->enemies->y, params->enemies->radius, params->enemies->slots.count);
+        enemyGrid = params->enemyGrid;
+    }
+    PROFILE_END(PROFILE_BROADPHASE);
+
+    PROFILE_BEGIN(PROFILE_FIRING);
+    FireBullet(params->player, params->bulletManager, params->enemies, enemyGrid, *(params->powerUpsCollected), 0.05f, params->deltaTime);
+    PROFILE_END(PROFILE_FIRING);
+
     //
     /* Collision Detection: Check for collisions between bullets and enemies, and between the player and power-ups. */
     //
     // Collision Detection
-    CheckBulletEnemyCollisions(params->bulletManager, params->enemies, params->enemyCount, params->enemiesShot, params->hitEnemyIndex);
-    CheckPowerUpCollection(params->player, params->powerUp, params->powerUpsCollected);
+    PROFILE_BEGIN(PROFILE_COLLISIONS);
+    CheckBulletEnemyCollisions(params->bulletManager, params->enemies, enemyGrid, params->enemiesShot, params->particles);
+    PROFILE_END(PROFILE_COLLISIONS);
+
+    PROFILE_BEGIN(PROFILE_POWER_UPS);
+    CheckPowerUpCollection(params->player, params->powerUpManager, params->powerUpsCollected, params->particles);
 
     // Spawn power-up if conditions are met
-    if (!params->powerUp->active && (*(params->enemiesShot) != 0) && (*(params->enemiesShot) % 10 == 0)) {
-        SpawnPowerUp(params->powerUp, params->player);
+    if (params->powerUpManager->slots.count == 0 && (*(params->enemiesShot) != 0) && (*(params->enemiesShot) % 10 == 0)) {
+        SpawnPowerUp(params->powerUpManager, params->player, params->platform, &params->rng[GAME_RNG_POWER_UP]);
     }
+    PROFILE_END(PROFILE_POWER_UPS);
 
-    // Spawn new enemies based on the updated enemy spawn variable
-    if (GetRandomValue(0, 100) < *(params->enemySpawnVar) && *(params->enemyCount) < MAX_ENEMIES) {
+    // Spawn new enemies based on the updated enemy spawn variable; the rolls were tuned per 60 Hz frame
+    PROFILE_BEGIN(PROFILE_SPAWNING);
+    if (RngRange(&params->rng[GAME_RNG_SPAWN], 0, 100 * TICK_RATE / 60) < *(params->enemySpawnVar) && params->enemies->slots.count < params->enemies->slots.maxCapacity) {
         SpawnEnemy(params);
     }
+    PROFILE_END(PROFILE_SPAWNING);
 
     // Wave system: update timer and end wave if needed
+    PROFILE_BEGIN(PROFILE_WAVES);
     *(params->waveTimer) += params->deltaTime;
     if (*(params->waveTimer) >= WAVE_DURATION) {
-        *(params->enemyCount) = 0;
+        ClearEnemies(params->enemies);
         params->player->health++;
-        params->powerUp->active = false;
+        ClearSlotMap(&params->powerUpManager->slots);
         (*(params->currentWave))++;
         *(params->waveTimer) = 0.0f;
         (*(params->enemySpawnVar))++; // Increase enemy spawn variable
@@ -82,166 +160,222 @@ void GameLogic(GameLogicParams *params) {
 
     // Check for Player death and restart game state if health <= 0
     if (params->player->health <= 0) {
-        InitPlayer(params->player);
-        InitBulletManager(params->bulletManager);
-        *(params->enemyCount) = 0;
+        InitPlayer(params->player, params->platform);
+        ResetBulletManager(params->bulletManager);
+        ClearEnemies(params->enemies);
         *(params->powerUpsCollected) = 0;
         *(params->enemiesShot) = 0;
-        params->powerUp->active = false;
+        ClearSlotMap(&params->powerUpManager->slots);
+        ClearParticles(params->particles); // Debris from the last life would keep flying over the new round
         *(params->enemySpawnVar) = INITIAL_ENEMY_SPAWN_VAR;
         *(params->currentWave) = 1;
         *(params->waveTimer) = 0.0f;
     }
+    PROFILE_END(PROFILE_WAVES);
 }
 
-void InitPlayer(Player *player) {
-    player->position = (Vector2){400, 300}; // Center of the screen
+void InitPlayer(Player *player, const Platform *platform) {
+    // Centre of the arena: (ARENA_WIDTH / 2, ARENA_HEIGHT / 2) in the game, smaller in window-sized scenarios
+    player->position = (Vector2){ platform->GetArenaWidth() / 2.0f, platform->GetArenaHeight() / 2.0f };
+    player->previousPosition = player->position;
     player->radius = 20.0f;
     player->health = 10;
 }
 
-void InitBulletManager(BulletManager *bulletManager) {
-    bulletManager->bulletCount = 0; // Initialize bullet count
+void InitBulletManager(BulletManager *bulletManager, const PoolConfig *config) {
+    bulletManager->config = *config;
+    bulletManager->bullets = ReservePoolMemory(config->maxCapacity * sizeof(Bullet));
+    bulletManager->hits = ReservePoolMemory(config->maxCapacity * sizeof(int));
+    InitSlotMap(&bulletManager->slots, 0, config->maxCapacity);
+
+    int capacity = (config->initialCapacity < config->maxCapacity) ? config->initialCapacity : config->maxCapacity;
+    while (bulletManager->slots.capacity < capacity && GrowBulletManager(bulletManager)) { }
+
+    ResetBulletManager(bulletManager);
+}
+
+bool GrowBulletManager(BulletManager *bulletManager) {
+    int oldCapacity = bulletManager->slots.capacity;
+    int capacity = NextPoolCapacity(oldCapacity, &bulletManager->config);
+    if (capacity == oldCapacity || bulletManager->bullets == NULL || bulletManager->hits == NULL) return false; // Hard ceiling reached
+
+    if (!CommitPoolMemory(bulletManager->bullets, oldCapacity * sizeof(Bullet), capacity * sizeof(Bullet))) return false;
+    if (!CommitPoolMemory(bulletManager->hits, oldCapacity * sizeof(int), capacity * sizeof(int))) return false;
+    return GrowSlotMap(&bulletManager->slots, capacity);
+}
+
+void ResetBulletManager(BulletManager *bulletManager) {
+    ClearSlotMap(&bulletManager->slots); // Drop all bullets
     bulletManager->lastShotTime = 0.0f; // Reset shot timer
     bulletManager->bulletCooldown = 0.8f; // Set bullet cooldown
 }
 
+void InitPowerUpManager(PowerUpManager *powerUpManager) {
+    InitSlotMap(&powerUpManager->slots, MAX_POWER_UPS, MAX_POWER_UPS);
+}
+
+
+unsigned char ReadPlayerInput(const Platform *platform) {
+    unsigned char input = 0;
+    if (platform->IsKeyDown(KEY_W) || platform->IsKeyDown(KEY_UP)) input |= REPLAY_INPUT_UP;
+    if (platform->IsKeyDown(KEY_S) || platform->IsKeyDown(KEY_DOWN)) input |= REPLAY_INPUT_DOWN;
+    if (platform->IsKeyDown(KEY_A) || platform->IsKeyDown(KEY_LEFT)) input |= REPLAY_INPUT_LEFT;
+    if (platform->IsKeyDown(KEY_D) || platform->IsKeyDown(KEY_RIGHT)) input |= REPLAY_INPUT_RIGHT;
+    return input;
+}
 
-void UpdatePlayer(Player *player, float deltaTime) {
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) player->position.y -= PLAYER_SPEED * deltaTime;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) player->position.y += PLAYER_SPEED * deltaTime;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) player->position.x -= PLAYER_SPEED * deltaTime;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) player->position.x += PLAYER_SPEED * deltaTime;
+void UpdatePlayer(Player *player, unsigned char input, const Platform *platform, float deltaTime) {
+    player->previousPosition = player->position;
 
-    // Clamp player position to stay within screen boundaries
-    player->position.x = Clamp(player->position.x, player->radius, GetScreenWidth() - player->radius);
-    player->position.y = Clamp(player->position.y, player->radius, GetScreenHeight() - player->radius);
+    if (input & REPLAY_INPUT_UP) player->position.y -= PLAYER_SPEED * deltaTime;
+    if (input & REPLAY_INPUT_DOWN) player->position.y += PLAYER_SPEED * deltaTime;
+    if (input & REPLAY_INPUT_LEFT) player->position.x -= PLAYER_SPEED * deltaTime;
+    if (input & REPLAY_INPUT_RIGHT) player->position.x += PLAYER_SPEED * deltaTime;
+
+    // Clamp player position to stay within arena boundaries
+    player->position.x = Clamp(player->position.x, player->radius, platform->GetArenaWidth() - player->radius);
+    player->position.y = Clamp(player->position.y, player->radius, platform->GetArenaHeight() - player->radius);
 }
 
 void SpawnEnemy(GameLogicParams *params) {
-    if (*(params->enemyCount) >= MAX_ENEMIES) {
+    if (params->enemies->slots.count >= params->enemies->slots.maxCapacity) {
         TraceLog(LOG_DEBUG, "Max enemies reached, cannot spawn more.");
         return; // Ensure we don't exceed the max enemies
     }
-    Enemy newEnemy;
-    newEnemy.radius = 15.0f;
-    newEnemy.direction = (Vector2){0, 0};
+    int arenaWidth = params->platform->GetArenaWidth();
+    int arenaHeight = params->platform->GetArenaHeight();
 
-    int edge = GetRandomValue(0, 3); // 0: top, 1: bottom, 2: left, 3: right
+    Rng *rng = &params->rng[GAME_RNG_SPAWN];
+    Vector2 position = {0};
+    int edge = RngRange(rng, 0, 3); // 0: top, 1: bottom, 2: left, 3: right
     switch (edge) {
         case 0: // Top
-            newEnemy.position = (Vector2){GetRandomValue(0, GetScreenWidth()), 0};
-            newEnemy.direction = (Vector2){0, 1}; // Move down
+            position = (Vector2){RngRange(rng, 0, arenaWidth), 0};
             break;
         case 1: // Bottom
-            newEnemy.position = (Vector2){GetRandomValue(0, GetScreenWidth()), GetScreenHeight()};
-            newEnemy.direction = (Vector2){0, -1}; // Move up
+            position = (Vector2){RngRange(rng, 0, arenaWidth), arenaHeight};
             break;
         case 2: // Left
-            newEnemy.position = (Vector2){0, GetRandomValue(0, GetScreenHeight())};
-            newEnemy.direction = (Vector2){1, 0}; // Move right
+            position = (Vector2){0, RngRange(rng, 0, arenaHeight)};
             break;
         case 3: // Right
-            newEnemy.position = (Vector2){GetScreenWidth(), GetRandomValue(0, GetScreenHeight())};
-            newEnemy.direction = (Vector2){-1, 0}; // Move left
+            position = (Vector2){arenaWidth, RngRange(rng, 0, arenaHeight)};
             break;
     }
-    params->enemies[*params->enemyCount] = newEnemy;
-    (*(params->enemyCount))++;
+    AddEnemy(params->enemies, position.x, position.y, ENEMY_RADIUS);
+
+    // TraceLog(LOG_DEBUG, "Spawned enemy at position (%f, %f). Total enemies: %d",
+        // position.x, position.y, params->enemies->slots.count);
+}
 
-    // TraceLog(LOG_DEBUG, "Spawned enemy at position (%f, %f) with direction (%f, %f). Total enemies: %d",
-        // newEnemy.position.x, newEnemy.position.y, newEnemy.direction.x, newEnemy.direction.y, *(params->enemyCount));
+typedef struct {
+    Enemies *enemies;
+    float playerX, playerY, playerRadius;
+    float arenaWidth, arenaHeight;
+    float deltaTime;
+    int hits;
+} SeekJob;
+
+static void RunSeekJob(void *context, int start, int end) {
+    SeekJob *job = (SeekJob *)context;
+    int hits = SeekEnemyRange(job->enemies, start, end, job->playerX, job->playerY, job->playerRadius, job->arenaWidth, job->arenaHeight, job->deltaTime);
+    __atomic_add_fetch(&job->hits, hits, __ATOMIC_RELAXED); // A count, so the order chunks finish in can't change it
 }
 
 void UpdateEnemies(GameLogicParams *params) {
-    // TraceLog(LOG_DEBUG, "Updating enemies. Current enemy count: %d", *(params->enemyCount));
-
-    for (int i = 0; i < *(params->enemyCount); i++) {
-        // Calculate direction vector from enemy to player
-        Vector2 direction = (Vector2){params->player->position.x - params->enemies[i].position.x, params->player->position.y - params->enemies[i].position.y};
-
-        // Normalize the direction vector
-        direction = Vector2Normalize(direction);
-
-        // Move the enemy towards the player
-        params->enemies[i].position.x += direction.x * 100.0f * params->deltaTime; // Adjust speed as needed
-        params->enemies[i].position.y += direction.y * 100.0f * params->deltaTime; // Adjust speed as needed
-
-        // Clamp enemy position to stay within screen boundaries
-        params->enemies[i].position.x = Clamp(params->enemies[i].position.x, params->enemies[i].radius, GetScreenWidth() - params->enemies[i].radius);
-        params->enemies[i].position.y = Clamp(params->enemies[i].position.y, params->enemies[i].radius, GetScreenHeight() - params->enemies[i].radius);
-
-        // Check for collision with player
-        if (CheckCollision(params->player, &params->enemies[i])) {
-            // Decrease player's health
-            params->player->health--;
-            
-            // Remove enemy by shifting the rest of the array
-            for (int j = i; j < *(params->enemyCount) - 1; j++) {
-                params->enemies[j] = params->enemies[j + 1];
-            }
-            (*(params->enemyCount))--;
-            i--; // Adjust index after removal
-        }
+    // TraceLog(LOG_DEBUG, "Updating enemies. Current enemy count: %d", params->enemies->slots.count);
+    Player *player = params->player;
+    int arenaWidth = params->platform->GetArenaWidth();
+    int arenaHeight = params->platform->GetArenaHeight();
+
+    SaveEnemyPositions(params->enemies);
+
+    // Seek, move, clamp and test against the player in one vectorized pass, split across the job workers
+    SeekJob seek = { params->enemies, player->position.x, player->position.y, player->radius,
+        (float)arenaWidth, (float)arenaHeight, params->deltaTime, 0 };
+    ParallelFor(params->enemies->slots.count, ENEMY_JOB_CHUNK, RunSeekJob, &seek);
+    int hits = seek.hits;
+
+    // Each enemy that reached the player costs one health and is removed
+    if (hits > 0) {
+        player->health -= hits;
+        RemoveFlaggedEnemies(params->enemies, ENEMY_FLAG_HIT_PLAYER);
+    }
+
+    // Push overlapping enemies apart so the swarm spreads out instead of stacking on the player
+    if (params->separationIterations > 0) {
+        SeparateEnemies(params->enemies, params->enemyGrid, (float)arenaWidth, (float)arenaHeight, params->separationIterations);
     }
 
     // Spawn new enemies periodically
-    if (GetRandomValue(0, 500) < *(params->enemySpawnVar) && *(params->enemyCount) < MAX_ENEMIES) {
+    if (RngRange(&params->rng[GAME_RNG_SPAWN], 0, 500 * TICK_RATE / 60) < *(params->enemySpawnVar) && params->enemies->slots.count < params->enemies->slots.maxCapacity) {
         SpawnEnemy(params);
     }
 
-    // TraceLog(LOG_DEBUG, "Finished updating enemies. Current enemy count: %d", *(params->enemyCount));
+    // TraceLog(LOG_DEBUG, "Finished updating enemies. Current enemy count: %d", params->enemies->slots.count);
 }
 
-bool CheckCollision(Player *player, Enemy *enemy) {
-    return CheckCollisionCircles(player->position, player->radius, enemy->position, enemy->radius);
-}
-
-void UpdateBullets(BulletManager *bulletManager, float deltaTime) {
-    for (int i = 0; i < bulletManager->bulletCount; i++) {
-        Bullet *bullet = &bulletManager->bullets[i];
-        if (bullet->active) {
-            // Move the bullet
-            bullet->position.x += bullet->direction.x * bullet->speed * deltaTime;
-            bullet->position.y += bullet->direction.y * bullet->speed * deltaTime;
-
-            // Check if the bullet is off-screen
-            if (bullet->position.y < 0) {
-                bullet->active = false; // Deactivate bullet
-            }
+typedef struct {
+    Bullet *bullets;
+    float arenaWidth, arenaHeight;
+    float deltaTime;
+} MoveBulletsJob;
+
+static void RunMoveBulletsJob(void *context, int start, int end) {
+    MoveBulletsJob *job = (MoveBulletsJob *)context;
+    for (int i = start; i < end; i++) {
+        Bullet *bullet = &job->bullets[i];
+        if (!bullet->active) continue;
+
+        // Move the bullet
+        bullet->previousPosition = bullet->position;
+        bullet->position.x += bullet->direction.x * bullet->speed * job->deltaTime;
+        bullet->position.y += bullet->direction.y * bullet->speed * job->deltaTime;
+
+        // Check if the bullet left the arena
+        if (bullet->position.x < 0 || bullet->position.x > job->arenaWidth || bullet->position.y < 0 || bullet->position.y > job->arenaHeight) {
+            bullet->active = false; // Deactivate bullet
         }
     }
+}
+
+void UpdateBullets(BulletManager *bulletManager, const Platform *platform, float deltaTime) {
+    // Every bullet moves exactly once whichever thread moves it, so moving all of them before any removal
+    // leaves the same bullets, in the same slots, as moving and removing in one pass
+    MoveBulletsJob move = { bulletManager->bullets, (float)platform->GetArenaWidth(), (float)platform->GetArenaHeight(), deltaTime };
+    ParallelFor(bulletManager->slots.count, BULLET_JOB_CHUNK, RunMoveBulletsJob, &move);
 
-    // Remove inactive bullets
-    for (int i = 0; i < bulletManager->bulletCount; i++) {
+    for (int i = 0; i < bulletManager->slots.count; ) {
+        // Remove inactive bullets; the last bullet is swapped into slot i, so don't advance
         if (!bulletManager->bullets[i].active) {
-            // Shift the rest of the array
-            for (int j = i; j < bulletManager->bulletCount - 1; j++) {
-                bulletManager->bullets[j] = bulletManager->bullets[j + 1];
-            }
-            bulletManager->bulletCount--; // Decrease bullet count
-            i--; // Adjust index after removal
+            int moved = SlotMapRemove(&bulletManager->slots, i);
+            if (moved >= 0) bulletManager->bullets[i] = bulletManager->bullets[moved];
         }
+        else i++;
     }
 }
 
-void FireBullet(Player *player, BulletManager *bulletManager, Enemy enemies[], int enemyCount, int powerUpsCollected, float fireRateIncrease)
+void FireBullet(Player *player, BulletManager *bulletManager, Enemies *enemies, const SpatialGrid *enemyGrid, int powerUpsCollected, float fireRateIncrease, float deltaTime)
 {
-    bulletManager->lastShotTime += GetFrameTime();
+    bulletManager->lastShotTime += deltaTime;
     float effectiveBulletCooldown = bulletManager->bulletCooldown * (1.0f - (powerUpsCollected * fireRateIncrease));
 
     if (bulletManager->lastShotTime >= effectiveBulletCooldown) {
         // Find the closest enemy
-        Enemy *closestEnemy = FindClosestEnemy(enemies, enemyCount, player);
+        int closestEnemy = FindClosestEnemy(enemies, enemyGrid, player);
 
-        if (closestEnemy != NULL) {
+        if (closestEnemy >= 0) {
             // Check for available bullet slot
-            if (bulletManager->bulletCount < MAX_BULLETS) {
-                Bullet *newBullet = &bulletManager->bullets[bulletManager->bulletCount++];
+            bool hasRoom = (bulletManager->slots.count < bulletManager->slots.capacity) || GrowBulletManager(bulletManager);
+            Handle handle = hasRoom ? SlotMapInsert(&bulletManager->slots) : NULL_HANDLE;
+            if (handle.generation != 0) {
+                Bullet *newBullet = &bulletManager->bullets[bulletManager->slots.count - 1];
                 newBullet->position = player->position; // Start at player's position
+                newBullet->previousPosition = player->position;
 
                 // Calculate direction towards the closest enemy
-                Vector2 direction = Vector2Subtract(closestEnemy->position, player->position);
+                Vector2 target = {enemies->x[closestEnemy], enemies->y[closestEnemy]};
+                Vector2 direction = Vector2Subtract(target, player->position);
                 newBullet->direction = Vector2Normalize(direction); // Normalize the direction
 
                 newBullet->speed = PLAYER_SPEED * 4; // Set bullet speed
@@ -254,179 +388,201 @@ void FireBullet(Player *player, BulletManager *bulletManager, Enemy enemies[], i
 }
 
 
-Enemy* FindClosestEnemy(Enemy enemies[], int enemyCount, Player *player) {
-    Enemy *closestEnemy = NULL;
-    float closestDistance = SHOOTING_RANGE;
+int FindClosestEnemy(Enemies *enemies, const SpatialGrid *enemyGrid, Player *player) {
+    int closestEnemy = -1;
+    float closestDistanceSq;
 
-    for (int i = 0; i < enemyCount; i++) {
-        float distance = Vector2Distance(player->position, enemies[i].position);
-        if (distance < closestDistance) {
-            closestDistance = distance;
-            closestEnemy = &enemies[i];
-        }
+    if (FindClosestEnemies(enemies, enemyGrid, player->position, SHOOTING_RANGE, 1, &closestEnemy, &closestDistanceSq) == 0) {
+        return -1; // No enemy is within range
     }
+    return closestEnemy;
+}
 
-    return closestEnemy; // Returns NULL if no enemy is within range
+int FindClosestEnemies(Enemies *enemies, const SpatialGrid *enemyGrid, Vector2 position, float range, int k, int *closest, float *closestDistanceSq) {
+    // Ring search over the grid when there is one, otherwise a linear scan; both compare squared distances
+    if (enemyGrid != NULL) {
+        return QuerySpatialGridNearest(enemyGrid, position.x, position.y, range, k, closest, closestDistanceSq);
+    }
+    return QueryNearestBruteForce(enemies->x, enemies->y, enemies->slots.count, position.x, position.y, range, k, closest, closestDistanceSq);
 }
 
-void CheckBulletEnemyCollisions(BulletManager *bulletManager, Enemy enemies[], int *enemyCount, int *enemiesShot, int *hitEnemyIndex) {
-    for (int i = 0; i < bulletManager->bulletCount; i++) {
-        Bullet *bullet = &bulletManager->bullets[i];
-        if (bullet->active) {
-            for (int j = 0; j < *enemyCount; j++) {
-                Enemy *enemy = &enemies[j];
-                if (CheckCollisionCircles(bullet->position, bullet->radius, enemy->position, enemy->radius)) {
-                    // Collision detected
-                    bullet->active = false; // Deactivate the bullet
-
-                    // Increment enemiesShot
-                    (*enemiesShot)++;
-
-                    // Store the index of the hit enemy
-                    *hitEnemyIndex = j;
-
-                    // Remove the enemy by shifting the rest of the array
-                    for (int k = j; k < *enemyCount - 1; k++) {
-                        enemies[k] = enemies[k + 1];
-                    }
-                    (*enemyCount)--; // Decrease enemy count
-                    break; // Exit the inner loop since the bullet is now inactive
+// Lowest-index live enemy overlapping the bullet, testing every enemy
+static int FindBulletHitBruteForce(Bullet *bullet, Enemies *enemies) {
+    for (int j = 0; j < enemies->slots.count; j++) {
+        if (enemies->flags[j] & ENEMY_FLAG_DEAD) continue;
+        Vector2 enemyPosition = {enemies->x[j], enemies->y[j]};
+        if (CheckCollisionCircles(bullet->position, bullet->radius, enemyPosition, enemies->radius[j])) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+// Same answer as FindBulletHitBruteForce, testing only enemies in the cells the bullet can reach
+static int FindBulletHitGrid(Bullet *bullet, Enemies *enemies, const SpatialGrid *grid) {
+    float reach = bullet->radius + grid->maxRadius;
+    int column0, row0, column1, row1;
+    GetSpatialGridRange(grid, bullet->position.x - reach, bullet->position.y - reach,
+        bullet->position.x + reach, bullet->position.y + reach, &column0, &row0, &column1, &row1);
+
+    int hit = -1;
+    for (int row = row0; row <= row1; row++) {
+        for (int column = column0; column <= column1; column++) {
+            int cell = row * grid->columns + column;
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+                int j = grid->items[k];
+                if (hit >= 0 && j >= hit) break; // Cells are sorted, nothing lower left here
+                if (enemies->flags[j] & ENEMY_FLAG_DEAD) continue;
+                Vector2 enemyPosition = {enemies->x[j], enemies->y[j]};
+                if (CheckCollisionCircles(bullet->position, bullet->radius, enemyPosition, enemies->radius[j])) {
+                    hit = j;
+                    break;
                 }
             }
         }
     }
+    return hit;
 }
 
-void SpawnPowerUp(PowerUp *powerUp, Player *player) {
-    const float MIN_DISTANCE_FROM_PLAYER = 100.0f; // Minimum distance from player
+typedef struct {
+    BulletManager *bulletManager;
+    Enemies *enemies;
+    const SpatialGrid *enemyGrid;
+} FindHitsJob;
+
+static void RunFindHitsJob(void *context, int start, int end) {
+    FindHitsJob *job = (FindHitsJob *)context;
+    for (int i = start; i < end; i++) {
+        Bullet *bullet = &job->bulletManager->bullets[i];
+        if (!bullet->active) job->bulletManager->hits[i] = -1;
+        else if (job->enemyGrid != NULL) job->bulletManager->hits[i] = FindBulletHitGrid(bullet, job->enemies, job->enemyGrid);
+        else job->bulletManager->hits[i] = FindBulletHitBruteForce(bullet, job->enemies);
+    }
+}
 
-    do {
-        powerUp->position = (Vector2){GetRandomValue(50, GetScreenWidth() - 50), GetRandomValue(50, GetScreenHeight() - 50)};
-    } while (Vector2Distance(powerUp->position, player->position) < MIN_DISTANCE_FROM_PLAYER);
+void CheckBulletEnemyCollisions(BulletManager *bulletManager, Enemies *enemies, const SpatialGrid *enemyGrid, int *enemiesShot, Particles *particles) {
+    // Search every bullet in parallel against the enemies as they were at the start of the pass; nothing is
+    // flagged yet, so the searches only read
+    FindHitsJob find = { bulletManager, enemies, enemyGrid };
+    ParallelFor(bulletManager->slots.count, COLLISION_JOB_CHUNK, RunFindHitsJob, &find);
 
-    powerUp->radius = 15.0f; // Set power-up radius
-    powerUp->active = true; // Activate power-up
-}
+    // Kills are only flagged during the pass so enemy indices (and the grid) stay valid;
+    // each bullet takes the lowest-index live enemy it touches, whichever path finds it
+    for (int i = 0; i < bulletManager->slots.count; i++) {
+        Bullet *bullet = &bulletManager->bullets[i];
+        if (bullet->active) {
+            // Resolved in bullet order as before. The lowest enemy touched is still the answer unless an earlier
+            // bullet killed it this pass; only then is the bullet searched again, skipping the dead.
+            int j = bulletManager->hits[i];
+            if (j >= 0 && (enemies->flags[j] & ENEMY_FLAG_DEAD)) {
+                j = (enemyGrid != NULL) ? FindBulletHitGrid(bullet, enemies, enemyGrid) : FindBulletHitBruteForce(bullet, enemies);
+            }
+            if (j >= 0) {
+                // Collision detected
+                bullet->active = false; // Deactivate the bullet
 
-void CheckPowerUpCollection(Player *player, PowerUp *powerUp, int *powerUpsCollected) {
-    if (powerUp->active && CheckCollisionCircles(player->position, player->radius, powerUp->position, powerUp->radius)) {
-        (*powerUpsCollected)++; // Increase power-ups collected
-        powerUp->active = false; // Deactivate power-up
+                // Increment enemiesShot
+                (*enemiesShot)++;
+
+                enemies->flags[j] |= ENEMY_FLAG_DEAD;
+                EmitParticles(particles, enemies->x[j], enemies->y[j], ENEMY_DEATH_PARTICLES, ENEMY_DEATH_PARTICLE_SPEED, ENEMY_DEATH_PARTICLE_LIFETIME, m_colors[COLOR_ORANGE_RED]);
+            }
+        }
     }
+
+    RemoveFlaggedEnemies(enemies, ENEMY_FLAG_DEAD);
 }
 
+void SpawnPowerUp(PowerUpManager *powerUpManager, Player *player, const Platform *platform, Rng *rng) {
+    const float MIN_DISTANCE_FROM_PLAYER = 100.0f; // Minimum distance from player
 
-void DrawLogo() {
-    ClearBackground(m_colors[COLOR_DARK_GRAY]);
-    DrawText("My Game Logo", GetScreenWidth() / 2 - MeasureText("My Game Logo", 20) / 2, GetScreenHeight() / 2 - 10, 20, m_colors[COLOR_WHITE]);
-    DrawText("Created by Your Name", GetScreenWidth() / 2 - MeasureText("Created by Your Name", 20) / 2, GetScreenHeight() / 2 + 20, 20, m_colors[COLOR_WHITE]);
-}
+    Handle handle = SlotMapInsert(&powerUpManager->slots);
+    if (handle.generation == 0) return; // All power-up slots are taken
+    PowerUp *powerUp = &powerUpManager->powerUps[powerUpManager->slots.count - 1];
 
-void DrawMainMenu() {
-    ClearBackground(m_colors[COLOR_DARK_GRAY]);
-    DrawText("Main Menu", GetScreenWidth() / 2 - MeasureText("Main Menu", 40) / 2, GetScreenHeight() / 2 - 40, 40, m_colors[COLOR_WHITE]);
-    DrawText("1. Play Game", GetScreenWidth() / 2 - MeasureText("1. Play Game", 20) / 2, GetScreenHeight() / 2, 20, m_colors[COLOR_WHITE]);
-    DrawText("2. Settings", GetScreenWidth() / 2 - MeasureText("2. Settings", 20) / 2, GetScreenHeight() / 2 + 30, 20, m_colors[COLOR_WHITE]);
-    DrawText("3. Exit", GetScreenWidth() / 2 - MeasureText("3. Exit", 20) / 2, GetScreenHeight() / 2 + 60, 20, m_colors[COLOR_WHITE]);
-}
+    do {
+        powerUp->position = (Vector2){RngRange(rng, 50, platform->GetArenaWidth() - 50), RngRange(rng, 50, platform->GetArenaHeight() - 50)};
+    } while (Vector2Distance(powerUp->position, player->position) < MIN_DISTANCE_FROM_PLAYER);
 
-void DrawGame(GameLogicParams *params) {
-    ClearBackground(m_colors[COLOR_DARK_GRAY]);
-
-    DrawCircleV(params->player->position, params->player->radius, m_colors[COLOR_BLUE]);
-    DrawEnemies(params);
-    DrawBullets(params->bulletManager);
-    DrawText("Use WASD to move", 10, 10, 20, m_colors[COLOR_LIGHTER_GRAY]);
-
-    // Draw player health at a fixed position
-    char healthText[32];
-    sprintf(healthText, "Health: %d", params->player->health);
-    DrawText(healthText, 10, 40, 20, m_colors[COLOR_WHITE]);
-
-    // Draw wave information centered at the top
-    char waveText[32];
-    sprintf(waveText, "Wave: %d", *(params->currentWave));
-    int textWidth = MeasureText(waveText, 20);
-    DrawText(waveText, (GetScreenWidth() - textWidth) / 2, 10, 20, m_colors[COLOR_WHITE]);
-
-    // Optionally, display the remaining time for the current wave (in seconds)
-    char timerText[32];
-    sprintf(timerText, "Time: %d", (int)(WAVE_DURATION - *(params->waveTimer)));
-    int timerTextWidth = MeasureText(timerText, 20);
-    DrawText(timerText, (GetScreenWidth() - timerTextWidth) / 2, 40, 20, m_colors[COLOR_WHITE]);
-
-    // Draw enemies killed
-    char enemiesText[32];
-    sprintf(enemiesText, "Enemies Killed: %d", *(params->enemiesShot));
-    int enemiesTextWidth = MeasureText(enemiesText, 20);
-    DrawText(enemiesText, (GetScreenWidth() - enemiesTextWidth) - 100, 10, 20, m_colors[COLOR_WHITE]);
-
-    DrawDebugText(2,
-        *(params->enemyCount), "Enemy Count",
-        *(params->powerUpsCollected), "PowerUps Collected"
-    );
-
-    // Draw powerUp
-    if (params->powerUp->active) {
-        DrawCircleV(params->powerUp->position, params->powerUp->radius, m_colors[COLOR_GREEN]); // Draw power-up
-    }
+    powerUp->radius = 15.0f; // Set power-up radius
 }
 
-void DrawDebugText(int count, ...) {
-    va_list args;
-    va_start(args, count);
-
-    int x = 10;
-    int y = 70; //starting Y position
-    int fontSize = 16;
-
-    DrawText("[debug]", x, y, fontSize, m_colors[COLOR_WHITE]);
-    for (int i = 0; i < count; i++) {
-        y += 20;
-        int param = va_arg(args, int);
-        const char *string = va_arg(args, const char*);
-        char text[64];
-        sprintf(text, "%s: %d", string, param); // format the text
-        DrawText(text, x, y, fontSize, m_colors[COLOR_WHITE]);
-    }
-    va_end(args);
-}
+void CheckPowerUpCollection(Player *player, PowerUpManager *powerUpManager, int *powerUpsCollected, Particles *particles) {
+    for (int i = 0; i < powerUpManager->slots.count; ) {
+        PowerUp *powerUp = &powerUpManager->powerUps[i];
+        if (CheckCollisionCircles(player->position, player->radius, powerUp->position, powerUp->radius)) {
+            (*powerUpsCollected)++; // Increase power-ups collected
+            EmitParticles(particles, powerUp->position.x, powerUp->position.y, POWER_UP_PARTICLES, POWER_UP_PARTICLE_SPEED, POWER_UP_PARTICLE_LIFETIME, m_colors[COLOR_GREEN]);
 
-void DrawBullets(BulletManager *bulletManager) {
-    for (int i = 0; i < bulletManager->bulletCount; i++) {
-        Bullet *bullet = &bulletManager->bullets[i];
-        if (bullet->active) {
-            DrawCircleV(bullet->position, bullet->radius, m_colors[COLOR_LIGHT_YELLOW]); // Draw bullet
+            // Remove the power-up; the last one is swapped into slot i
+            int moved = SlotMapRemove(&powerUpManager->slots, i);
+            if (moved >= 0) powerUpManager->powerUps[i] = powerUpManager->powerUps[moved];
         }
+        else i++;
     }
 }
 
-void DrawEnemies(GameLogicParams *params) {
-    for (int i = 0; i < *params->enemyCount; i++) {
-        Enemy enemy = params->enemies[i];
-        DrawCircleV(enemy.position, enemy.radius, m_colors[COLOR_ORANGE_RED]);
-    }
+
+// Points into the simulation's own arrays, no copying; only valid until the next tick
+GameView GetGameView(const GameLogicParams *params) {
+    const Enemies *enemies = params->enemies;
+    GameView view = {
+        .playerPosition = params->player->position,
+        .playerPreviousPosition = params->player->previousPosition,
+        .playerRadius = params->player->radius,
+        .playerHealth = params->player->health,
+        .enemyX = enemies->x, .enemyY = enemies->y,
+        .enemyPreviousX = enemies->previousX, .enemyPreviousY = enemies->previousY,
+        .enemyRadius = enemies->radius,
+        .enemyCount = enemies->slots.count,
+        .bullets = params->bulletManager->bullets,
+        .bulletCount = params->bulletManager->slots.count,
+        .powerUps = params->powerUpManager->powerUps,
+        .powerUpCount = params->powerUpManager->slots.count,
+        .particleX = params->particles->x, .particleY = params->particles->y,
+        .particleVX = params->particles->vx, .particleVY = params->particles->vy,
+        .particleLife = params->particles->life,
+        .particleColor = params->particles->color,
+        .particleCount = params->particles->count,
+        .wave = *(params->currentWave),
+        .waveTimer = *(params->waveTimer),
+        .enemiesShot = *(params->enemiesShot),
+        .powerUpsCollected = *(params->powerUpsCollected),
+        .enemySpawnVar = *(params->enemySpawnVar),
+        .arenaWidth = params->platform->GetArenaWidth(),
+        .arenaHeight = params->platform->GetArenaHeight(),
+        .renderAlpha = params->renderAlpha
+    };
+    return view;
 }
 
 void ExitGameplay(GameLogicParams *gameParams) {
-    // Free any dynamically allocated resources if necessary
-    // For example, if you have dynamically allocated memory for enemies or bullets, free them here
+    // Entity pools stay allocated for the next run, UnloadGameParams() releases them at shutdown
 
-    // Reset game parameters if needed
-    *(gameParams->hitEnemyIndex) = -1;
-    *(gameParams->enemyCount) = 0;
-    *(gameParams->enemyCount) = 0;
+    // Reset game parameters if needed; a replay has to redo this before its next tick
+    if (gameParams->replay != NULL) MarkReplayReset(gameParams->replay);
+    ClearEnemies(gameParams->enemies);
     *(gameParams->powerUpsCollected) = 0;
     *(gameParams->enemiesShot) = 0;
-    gameParams->powerUp->active = false;
+    ClearSlotMap(&gameParams->powerUpManager->slots);
+    ClearParticles(gameParams->particles);
     *(gameParams->waveTimer) = 0.0f;
     *(gameParams->currentWave) = 1;
+    gameParams->accumulator = 0.0f;
+    gameParams->renderAlpha = 0.0f;
 }
 
-void DrawGameOver() {
-    ClearBackground(m_colors[COLOR_DARK_GRAY]);
-    DrawText("Game Over", GetScreenWidth() / 2 - MeasureText("Game Over", 40) / 2, GetScreenHeight() / 2 - 40, 40, m_colors[COLOR_WHITE]);
-    DrawText("Press R to Restart or M to go to Main Menu", GetScreenWidth() / 2 - MeasureText("Press R to Restart or M to go to Main Menu", 20) / 2, GetScreenHeight() / 2, 20, DARKGRAY);
+void UnloadGameParams(GameLogicParams *params) {
+    BulletManager *bulletManager = params->bulletManager;
+    ReleasePoolMemory(bulletManager->bullets, bulletManager->slots.maxCapacity * sizeof(Bullet), bulletManager->slots.capacity * sizeof(Bullet));
+    ReleasePoolMemory(bulletManager->hits, bulletManager->slots.maxCapacity * sizeof(int), bulletManager->slots.capacity * sizeof(int));
+    bulletManager->bullets = NULL;
+    bulletManager->hits = NULL;
+    UnloadSlotMap(&bulletManager->slots);
+    UnloadSlotMap(&params->powerUpManager->slots);
+    UnloadEnemies(params->enemies);
+    UnloadParticles(params->particles);
+    UnloadSpatialGrid(params->enemyGrid);
 }
 
 const char* SceneToString(Scene scene) {
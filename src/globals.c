@@ -25,3 +25,5 @@ int enemySpawnVar = INITIAL_ENEMY_SPAWN_VAR; // Variable to control enemy spawn
 int powerUpsCollected = 0; // Number of power-ups collected
 int enemiesShot = 0; // Track number of enemies shot
 float fireRateIncrease = 0.05f; // 5% increase in fire rate
+PoolConfig enemyPoolConfig = { ENEMY_POOL_INITIAL, POOL_GROW_CHUNK, ENEMY_POOL_MAX }; // Enemy pool capacities
+PoolConfig bulletPoolConfig = { BULLET_POOL_INITIAL, POOL_GROW_CHUNK, BULLET_POOL_MAX }; // Bullet pool capacities
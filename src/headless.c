@@ -0,0 +1,289 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+
+#include "game.h"
+#include "globals.h"
+#include "profiler.h"
+#include "scenario.h"
+#include "statehash.h"
+#include "autopilot.h"
+#include "jobs.h"
+#include "options.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// Headless simulation: runs GameLogic in a tight loop without a window, GPU or X server, one fixed tick per iteration.
+#define HEADLESS_USAGE "[--ticks N] [--width W] [--height H] " SIM_OPTIONS_USAGE " [--max-enemies N] [--max-bullets N] [--brute-force] [--separation N] [--trace FILE] [--replay FILE] [--record FILE] [--scenario FILE] [--hash-out FILE] [--hash-check FILE] [--autoplay]"
+// Determinism: run a replay or seed once with --hash-out, then again with --hash-check against that log, from the
+// same build with another --kernel, --jobs or --brute-force, or from a build with other compiler flags. The check
+// stops at the first tick whose state hash differs and names the part of the state that diverged.
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double GetWallTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    long ticks = TICK_RATE * 60L * 5L; // Five minutes of game time
+    int arenaWidth = ARENA_WIDTH;
+    int arenaHeight = ARENA_HEIGHT;
+    bool useBroadphase = true;
+    int separationIterations = SEPARATION_ITERATIONS;
+    const char *tracePath = NULL;
+    const char *replayPath = NULL;
+    const char *recordPath = NULL;
+    const char *scenarioPath = NULL;
+    const char *hashOutPath = NULL;
+    const char *hashCheckPath = NULL;
+    bool autoplay = false;
+    SimOptions options;
+    InitSimOptions(&options);
+
+    for (int i = 1; i < argc; i++) {
+        if (ParseSimOption(&options, argc, argv, &i)) continue;
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (strcmp(argv[i], "--width") == 0 && i + 1 < argc) arenaWidth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && i + 1 < argc) arenaHeight = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-enemies") == 0 && i + 1 < argc) enemyPoolConfig.maxCapacity = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-bullets") == 0 && i + 1 < argc) bulletPoolConfig.maxCapacity = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--brute-force") == 0) useBroadphase = false;
+        else if (strcmp(argv[i], "--separation") == 0 && i + 1 < argc) separationIterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) tracePath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) scenarioPath = argv[++i];
+        else if (strcmp(argv[i], "--hash-out") == 0 && i + 1 < argc) hashOutPath = argv[++i];
+        else if (strcmp(argv[i], "--hash-check") == 0 && i + 1 < argc) hashCheckPath = argv[++i];
+        else if (strcmp(argv[i], "--autoplay") == 0) autoplay = true;
+        else {
+            fprintf(stderr, "Usage: %s " HEADLESS_USAGE "\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetEnemyKernel(options.kernel);
+
+    // A replay brings its own seed, arena and length
+    Replay playback = {0};
+    if (replayPath != NULL) {
+        if (!LoadReplay(&playback, replayPath)) {
+            fprintf(stderr, "Could not load replay %s\n", replayPath);
+            return 1;
+        }
+        if (playback.tickRate != TICK_RATE) {
+            fprintf(stderr, "Replay %s was recorded at %d ticks/s, this build runs %d\n", replayPath, playback.tickRate, TICK_RATE);
+            UnloadReplay(&playback);
+            return 1;
+        }
+        options.seed = playback.seed;
+        arenaWidth = playback.arenaWidth;
+        arenaHeight = playback.arenaHeight;
+        ticks = playback.tickCount;
+    }
+
+    // So does a scenario, and it times every tick against its budget
+    Scenario scenario;
+    double *tickTimes = NULL;
+    if (scenarioPath != NULL) {
+        if (!LoadScenario(&scenario, scenarioPath)) {
+            fprintf(stderr, "Could not load scenario %s\n", scenarioPath);
+            return 1;
+        }
+        options.seed = scenario.seed;
+        arenaWidth = scenario.arenaWidth;
+        arenaHeight = scenario.arenaHeight;
+        ticks = scenario.ticks;
+        tickTimes = malloc(((ticks > 0) ? ticks : 1) * sizeof(double));
+        if (tickTimes == NULL) {
+            fprintf(stderr, "Could not allocate tick times for %ld ticks\n", ticks);
+            return 1;
+        }
+    }
+
+    Platform platform;
+    InitHeadlessPlatform(&platform, arenaWidth, arenaHeight, FIXED_TIMESTEP);
+
+    GameLogicParams gameLogicParams;
+    InitGameParams(&gameLogicParams, &platform);
+    SeedGameRng(&gameLogicParams, options.seed);
+    gameLogicParams.useBroadphase = useBroadphase;
+    gameLogicParams.separationIterations = separationIterations;
+
+    if (scenarioPath != NULL) ApplyScenario(&scenario, &gameLogicParams);
+
+    // The autopilot plays instead of the scripted keys; a replay already has its inputs
+    Autopilot autopilot;
+    if (autoplay && replayPath == NULL) {
+        InitAutopilot(&autopilot, options.seed);
+        gameLogicParams.autopilot = &autopilot;
+    }
+
+    Replay recording;
+    if (recordPath != NULL) {
+        InitReplay(&recording, options.seed, arenaWidth, arenaHeight);
+        gameLogicParams.replay = &recording;
+    }
+
+    // Per-tick state hashes, written for a later run to check against, or checked against an earlier one
+    FILE *hashOut = NULL;
+    FILE *hashCheck = NULL;
+    if (hashOutPath != NULL) {
+        hashOut = fopen(hashOutPath, "w");
+        if (hashOut == NULL || !WriteStateHashHeader(hashOut)) {
+            fprintf(stderr, "Could not write %s\n", hashOutPath);
+            return 1;
+        }
+    }
+    if (hashCheckPath != NULL) {
+        hashCheck = fopen(hashCheckPath, "r");
+        if (hashCheck == NULL) {
+            fprintf(stderr, "Could not open %s\n", hashCheckPath);
+            return 1;
+        }
+    }
+    long divergentTick = -1;
+    long checkedTicks = 0;
+
+    int maxEnemies = 0;
+    int maxParticles = 0;
+    int maxWave = 1;
+    InitJobSystem(options.jobWorkers);
+    double start = GetWallTime();
+
+    for (long tick = 0; tick < ticks; tick++) {
+        // Each tick is one profiler frame, but only when tracing so the plain run stays untimed
+        if (tracePath != NULL) PROFILE_BEGIN_FRAME();
+        if (replayPath != NULL) {
+            unsigned char input = playback.inputs[tick];
+            if (input & REPLAY_INPUT_RESET) ExitGameplay(&gameLogicParams);
+            SetHeadlessKeyDown(KEY_W, (input & REPLAY_INPUT_UP) != 0);
+            SetHeadlessKeyDown(KEY_S, (input & REPLAY_INPUT_DOWN) != 0);
+            SetHeadlessKeyDown(KEY_A, (input & REPLAY_INPUT_LEFT) != 0);
+            SetHeadlessKeyDown(KEY_D, (input & REPLAY_INPUT_RIGHT) != 0);
+        }
+        if (scenarioPath != NULL) {
+            ApplyScenarioTick(&scenario, &gameLogicParams, tick);
+            double tickStart = GetWallTime();
+            GameLogic(&gameLogicParams);
+            tickTimes[tick] = (GetWallTime() - tickStart) * 1000.0;
+        }
+        else GameLogic(&gameLogicParams);
+        if (tracePath != NULL) PROFILE_END_FRAME();
+
+        if (hashOut != NULL || hashCheck != NULL) {
+            StateHash hash;
+            HashGameState(&gameLogicParams, &hash);
+            if (hashOut != NULL) WriteStateHash(hashOut, tick, &hash);
+            if (hashCheck != NULL) {
+                long expectedTick;
+                StateHash expected;
+                if (!ReadStateHash(hashCheck, &expectedTick, &expected) || expectedTick != tick) {
+                    printf("hash check: %s ends at tick %ld\n", hashCheckPath, tick);
+                    fclose(hashCheck);
+                    hashCheck = NULL;
+                }
+                else if (expected.combined != hash.combined) {
+                    int field = FindStateHashDivergence(&expected, &hash);
+                    divergentTick = tick;
+                    if (field < 0) { // Every field agrees, so the log line itself is damaged
+                        printf("hash check: diverged at tick %ld in the combined hash only (expected %016llx, got %016llx)\n", tick,
+                            (unsigned long long)expected.combined, (unsigned long long)hash.combined);
+                    }
+                    else {
+                        printf("hash check: diverged at tick %ld in %s (expected %016llx, got %016llx)\n", tick,
+                            StateFieldToString((StateField)field), (unsigned long long)expected.fields[field], (unsigned long long)hash.fields[field]);
+                    }
+                    ticks = tick + 1; // Everything after the first divergence is noise
+                }
+                else checkedTicks++;
+            }
+        }
+
+        if (gameLogicParams.enemies->slots.count > maxEnemies) maxEnemies = gameLogicParams.enemies->slots.count;
+        if (gameLogicParams.particles->count > maxParticles) maxParticles = gameLogicParams.particles->count;
+        if (*(gameLogicParams.currentWave) > maxWave) maxWave = *(gameLogicParams.currentWave);
+    }
+
+    double elapsed = GetWallTime() - start;
+
+    printf("kernel: %s\n", EnemyKernelToString(GetEnemyKernel()));
+    printf("collisions: %s\n", useBroadphase ? "grid" : "brute-force");
+    printf("job workers: %d\n", GetJobWorkerCount());
+    printf("ticks: %ld\n", ticks);
+    printf("elapsed: %.3f s\n", elapsed);
+    printf("ticks/s: %.0f\n", (elapsed > 0.0) ? ticks / elapsed : 0.0);
+    printf("wave: %d (max %d)\n", *(gameLogicParams.currentWave), maxWave);
+    printf("enemies: %d (max %d)\n", gameLogicParams.enemies->slots.count, maxEnemies);
+    printf("enemies shot: %d\n", *(gameLogicParams.enemiesShot));
+    printf("particles: %d (max %d, dropped %d)\n", gameLogicParams.particles->count, maxParticles, gameLogicParams.particles->dropped);
+    printf("player: %s\n", (gameLogicParams.autopilot != NULL) ? "autopilot" : "scripted");
+    printf("player health: %d\n", gameLogicParams.player->health);
+    printf("pool memory: %zu KiB committed, %zu KiB reserved\n", GetPoolMemoryStats().committedBytes / 1024, GetPoolMemoryStats().reservedBytes / 1024);
+
+    // Tick time percentiles after warmup, checked against the scenario's budget
+    int exitCode = 0;
+    if (scenarioPath != NULL) {
+        long warmup = (scenario.warmupTicks < ticks) ? scenario.warmupTicks : 0;
+        long measured = ticks - warmup;
+        if (measured > 0) {
+            qsort(tickTimes + warmup, measured, sizeof(double), CompareDoubles);
+            double p50 = tickTimes[warmup + measured / 2];
+            double p99 = tickTimes[warmup + (long)ceil(0.99 * measured) - 1];
+            double worst = tickTimes[ticks - 1];
+            printf("scenario: %s\n", scenario.name);
+            printf("tick time: p50 %.3f ms, p99 %.3f ms, max %.3f ms over %ld ticks\n", p50, p99, worst, measured);
+            if (scenario.budgetP99Ms > 0.0f) {
+                bool pass = p99 <= scenario.budgetP99Ms;
+                printf("budget: p99 %.3f ms %s %.3f ms, %s\n", p99, pass ? "<=" : ">", scenario.budgetP99Ms, pass ? "PASS" : "FAIL");
+                if (!pass) exitCode = 2;
+            }
+        }
+        free(tickTimes);
+    }
+
+    if (hashOut != NULL) {
+        fclose(hashOut);
+        printf("hashes: %s\n", hashOutPath);
+    }
+    if (hashCheckPath != NULL) {
+        if (hashCheck != NULL) fclose(hashCheck);
+        if (divergentTick >= 0) exitCode = 3;
+        else if (checkedTicks < ticks) {
+            // A short or empty log proves nothing about the ticks it doesn't cover
+            printf("hash check: only %ld of %ld ticks checked, %s is incomplete\n", checkedTicks, ticks, hashCheckPath);
+            exitCode = 3;
+        }
+        else printf("hash check: %ld ticks match %s\n", checkedTicks, hashCheckPath);
+    }
+
+    if (tracePath != NULL) {
+#ifdef PROFILER_ENABLED
+        if (ProfilerExportChromeTrace(tracePath)) printf("trace: %s (last %d ticks)\n", tracePath, ProfilerFrameCount());
+        else fprintf(stderr, "Could not write %s\n", tracePath);
+#else
+        fprintf(stderr, "Profiler compiled out, no trace written\n");
+#endif
+    }
+
+    if (replayPath != NULL) {
+        printf("replay: %s (seed %llu, %dx%d)\n", replayPath, (unsigned long long)options.seed, arenaWidth, arenaHeight);
+        UnloadReplay(&playback);
+    }
+    if (recordPath != NULL) {
+        if (!SaveReplay(&recording, recordPath)) fprintf(stderr, "Could not write %s\n", recordPath);
+        UnloadReplay(&recording);
+    }
+
+    UnloadJobSystem();
+    UnloadGameParams(&gameLogicParams);
+
+    return exitCode;
+}
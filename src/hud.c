@@ -0,0 +1,57 @@
+#include "hud.h"
+#include "globals.h"
+#include "render.h"
+#include <stdio.h>
+
+void InitHud(Hud *hud, int width) {
+    hud->target = LoadRenderTexture(width, HUD_HEIGHT);
+    hud->width = width;
+    hud->valid = false;
+    hud->redraws = 0;
+}
+
+void UnloadHud(Hud *hud) {
+    if (hud->target.id != 0) UnloadRenderTexture(hud->target);
+    hud->target = (RenderTexture2D){ 0 };
+    hud->valid = false;
+}
+
+bool UpdateHud(Hud *hud, int health, int wave, int secondsLeft, int enemiesShot) {
+    if (hud->valid && health == hud->health && wave == hud->wave && secondsLeft == hud->secondsLeft && enemiesShot == hud->enemiesShot) {
+        return false;
+    }
+    hud->health = health;
+    hud->wave = wave;
+    hud->secondsLeft = secondsLeft;
+    hud->enemiesShot = enemiesShot;
+
+    // Same layout DrawGame used to draw every frame
+    BeginTextureMode(hud->target);
+    ClearBackground(BLANK);
+    DrawText("Use WASD to move", 10, 10, 20, m_colors[COLOR_LIGHTER_GRAY]);
+
+    char text[32];
+    sprintf(text, "Health: %d", health);
+    DrawText(text, 10, 40, 20, m_colors[COLOR_WHITE]);
+
+    sprintf(text, "Wave: %d", wave);
+    DrawText(text, (hud->width - MeasureText(text, 20)) / 2, 10, 20, m_colors[COLOR_WHITE]);
+
+    sprintf(text, "Time: %d", secondsLeft);
+    DrawText(text, (hud->width - MeasureText(text, 20)) / 2, 40, 20, m_colors[COLOR_WHITE]);
+
+    sprintf(text, "Enemies Killed: %d", enemiesShot);
+    DrawText(text, (hud->width - MeasureText(text, 20)) - 100, 10, 20, m_colors[COLOR_WHITE]);
+    FlushRenderBatch(); // EndTextureMode would flush it unseen by the render statistics
+    EndTextureMode();
+
+    hud->valid = true;
+    hud->redraws++;
+    return true;
+}
+
+void DrawHud(const Hud *hud) {
+    // Render textures are stored bottom-up, hence the negative source height
+    Rectangle source = { 0.0f, 0.0f, (float)hud->target.texture.width, -(float)hud->target.texture.height };
+    DrawTextureRec(hud->target.texture, source, (Vector2){ 0.0f, 0.0f }, WHITE);
+}
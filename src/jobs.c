@@ -0,0 +1,210 @@
+#include "jobs.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Chunks left to one participant, [begin, end) packed as begin | end << 32 so a single compare-and-swap takes
+// from either side. Padded to a cache line so the owner popping and a thief stealing don't share one.
+typedef struct {
+    uint64_t range;
+    char padding[64 - sizeof(uint64_t)];
+} JobQueue;
+
+typedef struct {
+    pthread_t threads[JOB_MAX_WORKERS];
+    int workerCount;
+    JobQueue queues[JOB_MAX_WORKERS + 1]; // Index 0 is the submitting thread
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int generation; // Bumped for every ParallelFor that wakes the workers
+    int sleeping; // Workers blocked on wake
+    int active; // Workers that picked up the current job and haven't left it
+    int pending; // Chunks of the current job not yet finished
+    bool stopping;
+
+    // The current job, read by workers under lock; fn is cleared once every chunk is done
+    JobFunction fn;
+    void *context;
+    int count;
+    int chunkSize;
+} JobSystem;
+
+static JobSystem jobs;
+
+static uint64_t PackRange(uint32_t begin, uint32_t end) {
+    return (uint64_t)begin | ((uint64_t)end << 32);
+}
+
+// A stale snapshot can never claim a chunk twice: the packed range is the whole state of a queue, so a
+// compare-and-swap that matches it is taking chunks nobody else has
+static int PopChunk(JobQueue *queue) {
+    uint64_t range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t begin = (uint32_t)range, end = (uint32_t)(range >> 32);
+        if (begin >= end) return -1;
+        if (__atomic_compare_exchange_n(&queue->range, &range, PackRange(begin + 1, end), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return (int)begin;
+        }
+    }
+}
+
+// Takes the back half of victim's chunks; the first one is returned and the rest become own's queue
+static int StealChunks(JobQueue *victim, JobQueue *own) {
+    uint64_t range = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t begin = (uint32_t)range, end = (uint32_t)(range >> 32);
+        if (begin >= end) return -1;
+        uint32_t middle = begin + (end - begin) / 2; // A single chunk goes to the thief whole
+        if (__atomic_compare_exchange_n(&victim->range, &range, PackRange(begin, middle), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&own->range, PackRange(middle + 1, end), __ATOMIC_RELEASE);
+            return (int)middle;
+        }
+    }
+}
+
+static void RunChunk(JobFunction fn, void *context, int count, int chunkSize, int chunk) {
+    int start = chunk * chunkSize;
+    int end = (count - start < chunkSize) ? count : start + chunkSize;
+    fn(context, start, end);
+    __atomic_sub_fetch(&jobs.pending, 1, __ATOMIC_RELEASE);
+}
+
+// Own chunks first, then steals; returns once a full sweep found nothing left to take anywhere
+static void RunParticipant(int self, JobFunction fn, void *context, int count, int chunkSize) {
+    int participants = jobs.workerCount + 1;
+    JobQueue *own = &jobs.queues[self];
+
+    for (;;) {
+        int chunk = PopChunk(own);
+        for (int i = 1; chunk < 0 && i < participants; i++) {
+            chunk = StealChunks(&jobs.queues[(self + i) % participants], own);
+        }
+        if (chunk < 0) return;
+        RunChunk(fn, context, count, chunkSize, chunk);
+    }
+}
+
+static void *RunJobWorker(void *argument) {
+    int self = (int)(intptr_t)argument;
+    int seen = 0;
+
+    for (;;) {
+        // Spin a little first: the next ParallelFor of a tick usually follows within microseconds
+        for (int spin = 0; spin < JOB_SPIN_COUNT && __atomic_load_n(&jobs.generation, __ATOMIC_ACQUIRE) == seen; spin++) {
+            if ((spin & 63) == 63) sched_yield();
+        }
+
+        pthread_mutex_lock(&jobs.lock);
+        while (jobs.generation == seen && !jobs.stopping) {
+            jobs.sleeping++;
+            pthread_cond_wait(&jobs.wake, &jobs.lock);
+            jobs.sleeping--;
+        }
+        if (jobs.stopping) {
+            pthread_mutex_unlock(&jobs.lock);
+            return NULL;
+        }
+        // Joining under the lock keeps the submitter from starting the next job before this one lets go
+        seen = jobs.generation;
+        if (jobs.fn == NULL) { // Woke after the job was already finished
+            pthread_mutex_unlock(&jobs.lock);
+            continue;
+        }
+        JobFunction fn = jobs.fn;
+        void *context = jobs.context;
+        int count = jobs.count;
+        int chunkSize = jobs.chunkSize;
+        __atomic_add_fetch(&jobs.active, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&jobs.lock);
+
+        RunParticipant(self, fn, context, count, chunkSize);
+        __atomic_sub_fetch(&jobs.active, 1, __ATOMIC_RELEASE);
+    }
+}
+
+static int GetCpuCount(void) {
+#ifdef _WIN32
+    const char *processors = getenv("NUMBER_OF_PROCESSORS");
+    int cpus = (processors != NULL) ? atoi(processors) : 1;
+#else
+    int cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (cpus > 0) ? cpus : 1;
+}
+
+void InitJobSystem(int workers) {
+    memset(&jobs, 0, sizeof(JobSystem));
+    if (workers == JOB_WORKERS_AUTO) workers = GetCpuCount() - 1;
+    if (workers > JOB_MAX_WORKERS) workers = JOB_MAX_WORKERS;
+    if (workers <= 0) return;
+
+    pthread_mutex_init(&jobs.lock, NULL);
+    pthread_cond_init(&jobs.wake, NULL);
+    for (int i = 0; i < workers; i++) {
+        if (pthread_create(&jobs.threads[i], NULL, RunJobWorker, (void *)(intptr_t)(i + 1)) != 0) break;
+        jobs.workerCount++;
+    }
+}
+
+void UnloadJobSystem(void) {
+    if (jobs.workerCount > 0) {
+        pthread_mutex_lock(&jobs.lock);
+        jobs.stopping = true;
+        pthread_cond_broadcast(&jobs.wake);
+        pthread_mutex_unlock(&jobs.lock);
+        for (int i = 0; i < jobs.workerCount; i++) pthread_join(jobs.threads[i], NULL);
+
+        pthread_cond_destroy(&jobs.wake);
+        pthread_mutex_destroy(&jobs.lock);
+    }
+    memset(&jobs, 0, sizeof(JobSystem));
+}
+
+int GetJobWorkerCount(void) {
+    return jobs.workerCount;
+}
+
+void ParallelFor(int count, int chunkSize, JobFunction fn, void *context) {
+    if (count <= 0) return;
+    if (chunkSize < 1) chunkSize = 1;
+    int chunks = (count + chunkSize - 1) / chunkSize;
+
+    // Nothing to share: skip the hand-off entirely
+    if (jobs.workerCount == 0 || chunks == 1) {
+        fn(context, 0, count);
+        return;
+    }
+
+    // Deal the chunks out evenly; workers are idle between jobs, so nobody reads the queues while they change
+    int participants = jobs.workerCount + 1;
+    for (int i = 0; i < participants; i++) {
+        uint32_t begin = (uint32_t)((long long)chunks * i / participants);
+        uint32_t end = (uint32_t)((long long)chunks * (i + 1) / participants);
+        __atomic_store_n(&jobs.queues[i].range, PackRange(begin, end), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&jobs.pending, chunks, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&jobs.lock);
+    jobs.fn = fn;
+    jobs.context = context;
+    jobs.count = count;
+    jobs.chunkSize = chunkSize;
+    __atomic_add_fetch(&jobs.generation, 1, __ATOMIC_RELEASE);
+    if (jobs.sleeping > 0) pthread_cond_broadcast(&jobs.wake);
+    pthread_mutex_unlock(&jobs.lock);
+
+    RunParticipant(0, fn, context, count, chunkSize);
+
+    // Chunks stolen from us may still be running
+    while (__atomic_load_n(&jobs.pending, __ATOMIC_ACQUIRE) > 0) sched_yield();
+
+    // Close the job to late joiners, then wait for those still sweeping the queues before they are dealt again
+    pthread_mutex_lock(&jobs.lock);
+    jobs.fn = NULL;
+    pthread_mutex_unlock(&jobs.lock);
+    while (__atomic_load_n(&jobs.active, __ATOMIC_ACQUIRE) > 0) sched_yield();
+}
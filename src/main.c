@@ -1,7 +1,50 @@
-#include "game.h"
+#include "draw.h"
 #include "globals.h"
+#include "profiler.h"
+#include "autopilot.h"
+#include "render.h"
+#include "simthread.h"
+#include "capture.h"
+#include "jobs.h"
+#include "options.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GAME_USAGE "[--record FILE] [--telemetry FILE] [--autoplay] [--threaded] [--capture PATH] [--frames N] " SIM_OPTIONS_USAGE
+//   --record saves a replay of the session for game_headless --replay
+//   --telemetry writes per-wave frame, update and draw time percentiles as CSV
+//   --autoplay starts with the autopilot playing; F3 toggles it in game
+//   --threaded runs the simulation on its own thread, overlapping the next ticks with drawing the last
+//   --capture records every frame: a .y4m path gets one raw video stream, anything else is a directory of PNGs
+//   --frames exits after N frames, for unattended captures under a headless X server
+//   --seed replaces the clock as the seed, to play the same run again
+//   --kernel picks the enemy update kernel, the best the CPU has by default
+//   --jobs sets the helper threads the simulation's data-parallel loops share, 0 runs them serially; one per core by default
+int main(int argc, char *argv[]) {
+    const char *recordPath = NULL;
+    const char *telemetryPath = NULL;
+    bool autoplay = false;
+    bool threaded = false;
+    const char *capturePath = NULL;
+    long frameLimit = 0;
+    SimOptions options;
+    InitSimOptions(&options);
+    options.seed = (uint64_t)time(NULL); // A different run every launch
+    for (int i = 1; i < argc; i++) {
+        if (ParseSimOption(&options, argc, argv, &i)) continue;
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) telemetryPath = argv[++i];
+        else if (strcmp(argv[i], "--autoplay") == 0) autoplay = true;
+        else if (strcmp(argv[i], "--threaded") == 0) threaded = true;
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) capturePath = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frameLimit = atol(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s " GAME_USAGE "\n", argv[0]);
+            return 1;
+        }
+    }
 
-int main(void) {
     SetTraceLogLevel(LOG_ALL);
     //
     /* Initialization: Set up the window and initialize game entities. */
@@ -12,28 +55,64 @@ int main(void) {
     InitWindow(screenWidth, screenHeight, "Reverse Bullet Hell Survivor Roguelike");
 
     SearchAndSetResourceDir("resources");
+    InitCircleRenderer();
+    InitRenderBatchStats();
+    Hud hud;
+    InitHud(&hud, screenWidth);
 
     Scene currentScene = LOGO;
     float logoTimer = 0.0f;
 
+    Platform platform;
+    InitRaylibPlatform(&platform);
+    SetEnemyKernel(options.kernel);
+    InitJobSystem(options.jobWorkers);
+
     GameLogicParams gameLogicParams;
-    InitGameParams(&gameLogicParams);
+    InitGameParams(&gameLogicParams, &platform);
+    SeedGameRng(&gameLogicParams, options.seed);
+
+    Autopilot autopilot;
+    InitAutopilot(&autopilot, options.seed);
+    if (autoplay) gameLogicParams.autopilot = &autopilot;
+
+    // Owns the params while it runs; stopped whenever the scene leaves the game
+    SimThread sim;
+    InitSimThread(&sim, &gameLogicParams);
+
+    Replay replay;
+    if (recordPath != NULL) {
+        InitReplay(&replay, options.seed, platform.GetArenaWidth(), platform.GetArenaHeight());
+        gameLogicParams.replay = &replay;
+    }
+
+    Telemetry telemetry;
+    if (!InitTelemetry(&telemetry, telemetryPath)) TraceLog(LOG_WARNING, "TELEMETRY: [%s] Failed to open CSV", telemetryPath);
+
+    Capture capture = { 0 };
+    if (capturePath != NULL) {
+        CaptureFormat format = IsFileExtension(capturePath, ".y4m") ? CAPTURE_Y4M : CAPTURE_PNG;
+        if (!InitCapture(&capture, format, capturePath, GetRenderWidth(), GetRenderHeight(), 60)) TraceLog(LOG_WARNING, "CAPTURE: [%s] Failed to start", capturePath);
+    }
 
     SetTargetFPS(60);
+    long frameCount = 0;
     //
     /* Game Loop: Continuously update and draw the game until the window is closed. */
     //
-    while (!WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
-        gameLogicParams.deltaTime = deltaTime;
-        
+    while (!WindowShouldClose() && (frameLimit <= 0 || frameCount < frameLimit)) {
+        PROFILE_BEGIN_FRAME();
+        float frameTime = platform.GetFrameTime();
+        double updateMs = 0.0, drawMs = 0.0;
+        GameView view = { 0 };
 
 #ifdef DEV_MODE
         currentScene = GAME;
 #endif
+        if (threaded && currentScene != GAME) StopSimThread(&sim); // ExitGameplay below needs the params back
         switch (currentScene) {
             case LOGO:
-                logoTimer += GetFrameTime();
+                logoTimer += frameTime;
                 if (logoTimer >= 3.0f) { // Show logo for 3 seconds
                     currentScene = MAIN_MENU;
                 }
@@ -49,8 +128,15 @@ int main(void) {
                 }
                 break;
             case GAME:
-               if (!gameLogicParams.isGamePaused) {
-                    GameLogic(&gameLogicParams); // Only update game logic if not paused
+                if (threaded) {
+                    StartSimThread(&sim);
+                    SetSimThreadInput(&sim, ReadPlayerInput(&platform));
+                    SetSimThreadPaused(&sim, gameLogicParams.isGamePaused);
+                }
+                else if (!gameLogicParams.isGamePaused) {
+                    double updateStart = GetTime();
+                    StepGameLogic(&gameLogicParams, frameTime); // Fixed ticks, only while not paused
+                    updateMs = (GetTime() - updateStart) * 1000.0;
                 }
                 if (IsKeyPressed(KEY_P)) {
                     gameLogicParams.isGamePaused = !gameLogicParams.isGamePaused;
@@ -58,6 +144,20 @@ int main(void) {
                 else if (IsKeyPressed(KEY_SPACE)) {
                     currentScene = GAME_OVER;
                 }
+                else if (IsKeyPressed(KEY_F3)) {
+                    autoplay = !autoplay;
+                    if (threaded) SetSimThreadAutopilot(&sim, autoplay ? &autopilot : NULL);
+                    else gameLogicParams.autopilot = autoplay ? &autopilot : NULL;
+                }
+                else if (IsKeyPressed(KEY_F4)) {
+                    SetCirclePath((GetCirclePath() == CIRCLE_PATH_SPRITES) ? CIRCLE_PATH_SHAPES : CIRCLE_PATH_SPRITES);
+                    TraceLog(LOG_INFO, "Circle path: %s", CirclePathToString(GetCirclePath()));
+                }
+#ifdef PROFILER_ENABLED
+                if (IsKeyPressed(KEY_F2)) {
+                    if (ProfilerExportChromeTrace("profile.json")) TraceLog(LOG_INFO, "Wrote profile.json");
+                }
+#endif
                 break;
             case GAME_OVER:
                 ExitGameplay(&gameLogicParams);
@@ -73,6 +173,7 @@ int main(void) {
         }
 
         BeginDrawing();
+        BeginRenderFrame();
         switch (currentScene) {
             case LOGO:
                 DrawLogo();
@@ -80,22 +181,58 @@ int main(void) {
             case MAIN_MENU:
                 DrawMainMenu();
                 break;
-            case GAME:
-                DrawGame(&gameLogicParams);
+            case GAME: {
+                PROFILE_BEGIN(PROFILE_DRAW);
+                double drawStart = GetTime();
+                if (threaded) {
+                    bool fresh;
+                    const GameSnapshot *snapshot = AcquireSnapshot(&sim, &fresh);
+                    view = snapshot->view;
+                    updateMs = fresh ? snapshot->stepMs : 0.0; // A snapshot drawn again ran no step this frame
+                }
+                else view = GetGameView(&gameLogicParams);
+                DrawGame(&view, &hud);
+                DrawTelemetryOverlay(&telemetry, GetScreenWidth() - TELEMETRY_SPARKLINE_FRAMES - 10, 40);
+                DrawRenderStatsOverlay(GetScreenWidth() - TELEMETRY_SPARKLINE_FRAMES - 10, 110);
                 if (gameLogicParams.isGamePaused) {
                     DrawText("Game Paused", GetScreenWidth() / 2 - MeasureText("Game Paused", 20) / 2, GetScreenHeight() / 2 - 10, 20, RED);
                 }
+                drawMs = (GetTime() - drawStart) * 1000.0;
+                PROFILE_END(PROFILE_DRAW);
                 break;
+            }
             case GAME_OVER:
                 DrawGameOver();
                 break;
             }
+        EndRenderFrame();
+        CaptureFrame(&capture); // Copies into a free buffer or drops the frame; encoding happens on the workers
         EndDrawing();
+        frameCount++;
+        PROFILE_END_FRAME();
+
+        // Only gameplay frames count; menus and pause would flatten the percentiles
+        if (currentScene == GAME && !gameLogicParams.isGamePaused) {
+            RecordTelemetryFrame(&telemetry, frameTime * 1000.0f, (float)updateMs, (float)drawMs, &GetRenderFrameStats()->total, view.wave, view.enemySpawnVar, view.enemyCount);
+        }
     }
 
     //
     /* De-Initialization: Clean up resources and close the window. */
     //
+    UnloadSimThread(&sim); // Joins the simulation before anything it uses is released
+    UnloadCapture(&capture); // Waits for the frames still queued
+    UnloadJobSystem();
+    if (recordPath != NULL) {
+        if (SaveReplay(&replay, recordPath)) TraceLog(LOG_INFO, "REPLAY: [%s] Saved %ld ticks", recordPath, replay.tickCount);
+        else TraceLog(LOG_WARNING, "REPLAY: [%s] Failed to save", recordPath);
+        UnloadReplay(&replay);
+    }
+    UnloadTelemetry(&telemetry); // Summarise the wave in progress
+    UnloadGameParams(&gameLogicParams); // Release entity pools
+    UnloadRenderBatchStats();
+    UnloadCircleRenderer();
+    UnloadHud(&hud);
     CloseWindow(); // Close window and OpenGL context
 
     return 0;
@@ -0,0 +1,32 @@
+#include "options.h"
+#include "globals.h"
+#include "jobs.h"
+#include <stdlib.h>
+#include <string.h>
+
+void InitSimOptions(SimOptions *options) {
+    options->seed = GAME_DEFAULT_SEED;
+    options->kernel = ENEMY_KERNEL_AUTO;
+    options->jobWorkers = JOB_WORKERS_AUTO;
+}
+
+bool ParseSimOption(SimOptions *options, int argc, char *argv[], int *i) {
+    if (*i + 1 >= argc) return false; // Every shared option takes a value
+
+    const char *option = argv[*i];
+    const char *value = argv[*i + 1];
+    if (strcmp(option, "--seed") == 0) options->seed = (uint64_t)strtoull(value, NULL, 10);
+    else if (strcmp(option, "--jobs") == 0) options->jobWorkers = atoi(value);
+    else if (strcmp(option, "--kernel") == 0) {
+        // A misspelt kernel must not quietly run another one under a benchmark or a hash check
+        if (strcmp(value, "auto") == 0) options->kernel = ENEMY_KERNEL_AUTO;
+        else if (strcmp(value, "scalar") == 0) options->kernel = ENEMY_KERNEL_SCALAR;
+        else if (strcmp(value, "sse2") == 0) options->kernel = ENEMY_KERNEL_SSE2;
+        else if (strcmp(value, "avx2") == 0) options->kernel = ENEMY_KERNEL_AVX2;
+        else return false;
+    }
+    else return false;
+
+    (*i)++;
+    return true;
+}
@@ -0,0 +1,186 @@
+#include "particles.h"
+#include "enemies.h"
+#include "poolmem.h"
+#include <math.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define PARTICLE_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+// Every per-particle array, so reserve and release stay in lockstep
+typedef struct {
+    void **data;
+    size_t elementSize;
+} ParticleArray;
+
+#define PARTICLE_ARRAY_COUNT 7
+
+static void GetParticleArrays(Particles *particles, ParticleArray *arrays) {
+    arrays[0] = (ParticleArray){ (void **)&particles->x, sizeof(float) };
+    arrays[1] = (ParticleArray){ (void **)&particles->y, sizeof(float) };
+    arrays[2] = (ParticleArray){ (void **)&particles->vx, sizeof(float) };
+    arrays[3] = (ParticleArray){ (void **)&particles->vy, sizeof(float) };
+    arrays[4] = (ParticleArray){ (void **)&particles->life, sizeof(float) };
+    arrays[5] = (ParticleArray){ (void **)&particles->decay, sizeof(float) };
+    arrays[6] = (ParticleArray){ (void **)&particles->color, sizeof(Color) };
+}
+
+void InitParticles(Particles *particles, int capacity) {
+    ParticleArray arrays[PARTICLE_ARRAY_COUNT];
+    GetParticleArrays(particles, arrays);
+
+    particles->count = 0;
+    particles->capacity = capacity;
+    particles->dropped = 0;
+    particles->rng = RngStream(0, 0);
+
+    bool committed[PARTICLE_ARRAY_COUNT];
+    bool failed = false;
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; i++) {
+        size_t bytes = capacity * arrays[i].elementSize;
+        *arrays[i].data = ReservePoolMemory(bytes);
+        committed[i] = (*arrays[i].data != NULL) && CommitPoolMemory(*arrays[i].data, 0, bytes);
+        failed |= !committed[i];
+    }
+
+    // Without every array there is no pool; emits are then all dropped
+    if (failed) {
+        for (int i = 0; i < PARTICLE_ARRAY_COUNT; i++) {
+            size_t bytes = capacity * arrays[i].elementSize;
+            ReleasePoolMemory(*arrays[i].data, bytes, committed[i] ? bytes : 0);
+            *arrays[i].data = NULL;
+        }
+        particles->capacity = 0;
+    }
+}
+
+void UnloadParticles(Particles *particles) {
+    ParticleArray arrays[PARTICLE_ARRAY_COUNT];
+    GetParticleArrays(particles, arrays);
+
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; i++) {
+        size_t bytes = particles->capacity * arrays[i].elementSize;
+        ReleasePoolMemory(*arrays[i].data, bytes, bytes);
+        *arrays[i].data = NULL;
+    }
+    particles->count = 0;
+    particles->capacity = 0;
+}
+
+void ClearParticles(Particles *particles) {
+    particles->count = 0;
+}
+
+void EmitParticles(Particles *particles, float x, float y, int count, float speed, float lifetime, Color color) {
+    for (int n = 0; n < count; n++) {
+        if (particles->count >= particles->capacity) {
+            particles->dropped += count - n;
+            return;
+        }
+
+        // Slower and shorter-lived particles mixed in keep a burst from reading as a ring
+        float angle = RngNextFloat(&particles->rng) * 2.0f * PI;
+        float velocity = speed * (0.3f + 0.7f * RngNextFloat(&particles->rng));
+        float life = lifetime * (0.5f + 0.5f * RngNextFloat(&particles->rng));
+
+        int i = particles->count++;
+        particles->x[i] = x;
+        particles->y[i] = y;
+        particles->vx[i] = cosf(angle) * velocity;
+        particles->vy[i] = sinf(angle) * velocity;
+        particles->life[i] = 1.0f;
+        particles->decay[i] = 1.0f / life;
+        particles->color[i] = color;
+    }
+}
+
+// O(1) swap-remove: the last particle moves into index
+static void RemoveParticle(Particles *particles, int index) {
+    int last = --particles->count;
+    particles->x[index] = particles->x[last];
+    particles->y[index] = particles->y[last];
+    particles->vx[index] = particles->vx[last];
+    particles->vy[index] = particles->vy[last];
+    particles->life[index] = particles->life[last];
+    particles->decay[index] = particles->decay[last];
+    particles->color[index] = particles->color[last];
+}
+
+//
+/* Age kernels: same operations in the same order on every path, like the enemy kernels. */
+//
+static void AgeParticlesScalar(Particles *particles, int start, int end, float damping, float deltaTime) {
+    for (int i = start; i < end; i++) {
+        particles->x[i] = particles->x[i] + particles->vx[i] * deltaTime;
+        particles->y[i] = particles->y[i] + particles->vy[i] * deltaTime;
+        particles->vx[i] = particles->vx[i] * damping;
+        particles->vy[i] = particles->vy[i] * damping;
+        particles->life[i] = particles->life[i] - particles->decay[i] * deltaTime;
+    }
+}
+
+#ifdef PARTICLE_KERNEL_X86
+static void AgeParticlesSSE2(Particles *particles, int count, float damping, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 drag = _mm_set1_ps(damping);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(&particles->vx[i]);
+        __m128 vy = _mm_loadu_ps(&particles->vy[i]);
+        _mm_storeu_ps(&particles->x[i], _mm_add_ps(_mm_loadu_ps(&particles->x[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&particles->y[i], _mm_add_ps(_mm_loadu_ps(&particles->y[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&particles->vx[i], _mm_mul_ps(vx, drag));
+        _mm_storeu_ps(&particles->vy[i], _mm_mul_ps(vy, drag));
+        _mm_storeu_ps(&particles->life[i], _mm_sub_ps(_mm_loadu_ps(&particles->life[i]), _mm_mul_ps(_mm_loadu_ps(&particles->decay[i]), dt)));
+    }
+
+    AgeParticlesScalar(particles, i, count, damping, deltaTime);
+}
+
+__attribute__((target("avx2")))
+static void AgeParticlesAVX2(Particles *particles, int count, float damping, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 drag = _mm256_set1_ps(damping);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx = _mm256_loadu_ps(&particles->vx[i]);
+        __m256 vy = _mm256_loadu_ps(&particles->vy[i]);
+        _mm256_storeu_ps(&particles->x[i], _mm256_add_ps(_mm256_loadu_ps(&particles->x[i]), _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(&particles->y[i], _mm256_add_ps(_mm256_loadu_ps(&particles->y[i]), _mm256_mul_ps(vy, dt)));
+        _mm256_storeu_ps(&particles->vx[i], _mm256_mul_ps(vx, drag));
+        _mm256_storeu_ps(&particles->vy[i], _mm256_mul_ps(vy, drag));
+        _mm256_storeu_ps(&particles->life[i], _mm256_sub_ps(_mm256_loadu_ps(&particles->life[i]), _mm256_mul_ps(_mm256_loadu_ps(&particles->decay[i]), dt)));
+    }
+
+    AgeParticlesScalar(particles, i, count, damping, deltaTime);
+}
+#endif
+
+void UpdateParticles(Particles *particles, float deltaTime) {
+    float damping = 1.0f - PARTICLE_DRAG * deltaTime;
+    if (damping < 0.0f) damping = 0.0f;
+
+    switch (GetEnemyKernel()) {
+#ifdef PARTICLE_KERNEL_X86
+        case ENEMY_KERNEL_AVX2:
+            AgeParticlesAVX2(particles, particles->count, damping, deltaTime);
+            break;
+        case ENEMY_KERNEL_SSE2:
+            AgeParticlesSSE2(particles, particles->count, damping, deltaTime);
+            break;
+#endif
+        default:
+            AgeParticlesScalar(particles, 0, particles->count, damping, deltaTime);
+            break;
+    }
+
+    // Expired particles are rare per tick compared to live ones, so a separate pass over life alone is cheap
+    for (int i = 0; i < particles->count; ) {
+        if (particles->life[i] <= 0.0f) RemoveParticle(particles, i); // Re-test index i, it now holds the former last particle
+        else i++;
+    }
+}
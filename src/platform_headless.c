@@ -0,0 +1,49 @@
+#include "platform.h"
+#include "globals.h"
+
+#define HEADLESS_MAX_KEYS 512 // Covers every raylib KeyboardKey value
+
+static bool keysDown[HEADLESS_MAX_KEYS];
+static int arenaWidth = ARENA_WIDTH;
+static int arenaHeight = ARENA_HEIGHT;
+static float frameTime = 1.0f / 60.0f;
+
+static bool HeadlessIsKeyDown(int key) {
+    if (key < 0 || key >= HEADLESS_MAX_KEYS) return false;
+    return keysDown[key];
+}
+
+static int HeadlessGetArenaWidth(void) {
+    return arenaWidth;
+}
+
+static int HeadlessGetArenaHeight(void) {
+    return arenaHeight;
+}
+
+static float HeadlessGetFrameTime(void) {
+    return frameTime;
+}
+
+void InitHeadlessPlatform(Platform *platform, int width, int height, float fixedFrameTime) {
+    arenaWidth = width;
+    arenaHeight = height;
+    frameTime = fixedFrameTime;
+    ClearHeadlessKeys();
+
+    platform->IsKeyDown = HeadlessIsKeyDown;
+    platform->GetArenaWidth = HeadlessGetArenaWidth;
+    platform->GetArenaHeight = HeadlessGetArenaHeight;
+    platform->GetFrameTime = HeadlessGetFrameTime;
+}
+
+void SetHeadlessKeyDown(int key, bool down) {
+    if (key < 0 || key >= HEADLESS_MAX_KEYS) return;
+    keysDown[key] = down;
+}
+
+void ClearHeadlessKeys(void) {
+    for (int i = 0; i < HEADLESS_MAX_KEYS; i++) {
+        keysDown[i] = false;
+    }
+}
@@ -0,0 +1,23 @@
+#include "platform.h"
+#include "raylib.h"
+#include "globals.h"
+
+static bool RaylibIsKeyDown(int key) {
+    return IsKeyDown(key);
+}
+
+// The arena is the world, not the window, so resizing never changes the simulation
+static int RaylibGetArenaWidth(void) {
+    return ARENA_WIDTH;
+}
+
+static int RaylibGetArenaHeight(void) {
+    return ARENA_HEIGHT;
+}
+
+void InitRaylibPlatform(Platform *platform) {
+    platform->IsKeyDown = RaylibIsKeyDown;
+    platform->GetArenaWidth = RaylibGetArenaWidth;
+    platform->GetArenaHeight = RaylibGetArenaHeight;
+    platform->GetFrameTime = GetFrameTime;
+}
@@ -0,0 +1,93 @@
+#if !defined(_WIN32)
+    #define _DEFAULT_SOURCE // MAP_ANONYMOUS, MAP_NORESERVE
+#endif
+
+#include "poolmem.h"
+
+#if defined(_WIN32)
+    // Declared by hand instead of including windows.h, which clashes with raylib names
+    __declspec(dllimport) void *__stdcall VirtualAlloc(void *address, size_t size, unsigned long type, unsigned long protect);
+    __declspec(dllimport) int __stdcall VirtualFree(void *address, size_t size, unsigned long type);
+    #define POOL_MEM_COMMIT 0x00001000
+    #define POOL_MEM_RESERVE 0x00002000
+    #define POOL_MEM_RELEASE 0x00008000
+    #define POOL_PAGE_NOACCESS 0x01
+    #define POOL_PAGE_READWRITE 0x04
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+static PoolMemoryStats stats = {0};
+
+static size_t GetPageSize(void) {
+#if defined(_WIN32)
+    return 64 * 1024; // Allocation granularity
+#else
+    static size_t pageSize = 0;
+    if (pageSize == 0) pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    return pageSize;
+#endif
+}
+
+static size_t RoundToPage(size_t bytes) {
+    size_t pageSize = GetPageSize();
+    return (bytes + pageSize - 1) / pageSize * pageSize;
+}
+
+void *ReservePoolMemory(size_t bytes) {
+    size_t size = RoundToPage((bytes > 0) ? bytes : 1);
+
+#if defined(_WIN32)
+    void *base = VirtualAlloc(NULL, size, POOL_MEM_RESERVE, POOL_PAGE_NOACCESS);
+    if (base == NULL) return NULL;
+#else
+    void *base = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) return NULL;
+#endif
+
+    stats.reservedBytes += size;
+    return base;
+}
+
+bool CommitPoolMemory(void *base, size_t committedBytes, size_t bytes) {
+    size_t oldSize = RoundToPage(committedBytes);
+    size_t newSize = RoundToPage(bytes);
+    if (newSize <= oldSize) return true;
+
+    // Commit only the new pages; everything below oldSize is already backed
+#if defined(_WIN32)
+    if (VirtualAlloc((char *)base + oldSize, newSize - oldSize, POOL_MEM_COMMIT, POOL_PAGE_READWRITE) == NULL) return false;
+#else
+    if (mprotect((char *)base + oldSize, newSize - oldSize, PROT_READ | PROT_WRITE) != 0) return false;
+#endif
+
+    stats.committedBytes += newSize - oldSize;
+    return true;
+}
+
+void ReleasePoolMemory(void *base, size_t reservedBytes, size_t committedBytes) {
+    if (base == NULL) return;
+
+    size_t size = RoundToPage((reservedBytes > 0) ? reservedBytes : 1);
+#if defined(_WIN32)
+    VirtualFree(base, 0, POOL_MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+
+    stats.reservedBytes -= size;
+    stats.committedBytes -= RoundToPage(committedBytes);
+}
+
+int NextPoolCapacity(int capacity, const PoolConfig *config) {
+    if (capacity >= config->maxCapacity) return capacity;
+
+    int chunk = (config->growChunk > 0) ? config->growChunk : 1;
+    int next = (capacity <= config->maxCapacity - chunk) ? capacity + chunk : config->maxCapacity;
+    return next;
+}
+
+PoolMemoryStats GetPoolMemoryStats(void) {
+    return stats;
+}
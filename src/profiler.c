@@ -0,0 +1,144 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    // Declared by hand instead of including windows.h, which clashes with raylib names
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequency);
+#else
+    #include <time.h>
+#endif
+
+// Single writer (the thread running the frame), any number of readers. Frames are published by
+// bumping framesWritten after the entry's sequence turns even again. current is per thread, so scopes
+// timed on a thread that never begins a frame (the simulation thread) are dropped instead of racing.
+static ProfileFrame ring[PROFILE_FRAME_COUNT];
+static unsigned long long framesWritten = 0;
+static __thread ProfileFrame *current = NULL; // Entry being filled, NULL outside a frame
+
+double ProfilerNowUs(void) {
+#if defined(_WIN32)
+    static long long frequency = 0;
+    long long count;
+    if (frequency == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return (double)count * 1e6 / (double)frequency;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+#endif
+}
+
+void ProfilerBeginFrame(void) {
+    unsigned long long frame = __atomic_load_n(&framesWritten, __ATOMIC_RELAXED);
+    current = &ring[frame % PROFILE_FRAME_COUNT];
+
+    __atomic_store_n(&current->sequence, current->sequence + 1, __ATOMIC_RELAXED); // Odd: being written
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    current->frame = frame;
+    current->startUs = ProfilerNowUs();
+    current->durationUs = 0.0f;
+    memset(current->phaseUs, 0, sizeof(current->phaseUs));
+    current->ticks = 0;
+    current->eventCount = 0;
+}
+
+void ProfilerEndFrame(void) {
+    if (current == NULL) return;
+
+    current->durationUs = (float)(ProfilerNowUs() - current->startUs);
+    __atomic_store_n(&current->sequence, current->sequence + 1, __ATOMIC_RELEASE); // Even: complete
+    __atomic_store_n(&framesWritten, current->frame + 1, __ATOMIC_RELEASE);
+    current = NULL;
+}
+
+bool ProfilerActive(void) {
+    return current != NULL;
+}
+
+void ProfilerCountTick(void) {
+    if (current != NULL) current->ticks++;
+}
+
+void ProfilerRecord(ProfilePhase phase, double startUs, double endUs) {
+    if (current == NULL) return; // Outside a frame, e.g. the headless runner without --trace
+
+    float durationUs = (float)(endUs - startUs);
+    current->phaseUs[phase] += durationUs;
+    if (current->eventCount < PROFILE_MAX_EVENTS) {
+        current->events[current->eventCount++] = (ProfileEvent){ phase, (float)(startUs - current->startUs), durationUs };
+    }
+}
+
+bool ProfilerReadFrame(int age, ProfileFrame *frame) {
+    unsigned long long written = __atomic_load_n(&framesWritten, __ATOMIC_ACQUIRE);
+    if (age < 0 || age >= PROFILE_FRAME_COUNT || (unsigned long long)age >= written) return false;
+
+    const ProfileFrame *entry = &ring[(written - 1 - age) % PROFILE_FRAME_COUNT];
+    unsigned int before = __atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE);
+    if (before & 1) return false;
+
+    memcpy(frame, entry, sizeof(ProfileFrame));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    unsigned int after = __atomic_load_n(&entry->sequence, __ATOMIC_RELAXED);
+    return before == after && frame->frame == written - 1 - age;
+}
+
+int ProfilerFrameCount(void) {
+    unsigned long long written = __atomic_load_n(&framesWritten, __ATOMIC_ACQUIRE);
+    return (written < PROFILE_FRAME_COUNT) ? (int)written : PROFILE_FRAME_COUNT;
+}
+
+bool ProfilerExportChromeTrace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    // Oldest frame first; each frame is one event and its phases are nested inside it
+    static ProfileFrame frame;
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (int age = ProfilerFrameCount() - 1; age >= 0; age--) {
+        if (!ProfilerReadFrame(age, &frame)) continue;
+
+        fprintf(file, "%s{\"name\": \"Frame\", \"cat\": \"frame\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"frame\": %llu, \"ticks\": %d}}",
+            first ? "" : ",\n", frame.startUs, frame.durationUs, frame.frame, frame.ticks);
+        first = false;
+        for (int i = 0; i < frame.eventCount; i++) {
+            ProfileEvent *event = &frame.events[i];
+            fprintf(file, ",\n{\"name\": \"%s\", \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f}",
+                ProfilePhaseToString((ProfilePhase)event->phase), frame.startUs + event->startUs, event->durationUs);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return true;
+}
+
+const char* ProfilePhaseToString(ProfilePhase phase) {
+    switch (phase) {
+        case PROFILE_INPUT: return "Input";
+        case PROFILE_BULLETS: return "Bullets";
+        case PROFILE_ENEMIES: return "Enemies";
+        case PROFILE_BROADPHASE: return "Broadphase";
+        case PROFILE_FIRING: return "Firing";
+        case PROFILE_COLLISIONS: return "Collisions";
+        case PROFILE_POWER_UPS: return "PowerUps";
+        case PROFILE_SPAWNING: return "Spawning";
+        case PROFILE_WAVES: return "Waves";
+        case PROFILE_PARTICLES: return "Particles";
+        case PROFILE_DRAW: return "Draw";
+        default: return "Unknown";
+    }
+}
+
+#endif // PROFILER_ENABLED
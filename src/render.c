@@ -0,0 +1,377 @@
+#include "render.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static CirclePath activePath = CIRCLE_PATH_SPRITES;
+static Texture2D circleSprite = { 0 };
+static CircleDrawStats circleStats = { 0 };
+static bool cullEnabled = false;
+static float cullMinX, cullMinY, cullMaxX, cullMaxY;
+static float circleZoom = 1.0f;
+static unsigned char lodSegments[CIRCLE_LOD_TABLE_RADIUS];
+static CircleList circleList = { 0 };
+
+static bool CheckCircleBatchLimit(int vertices);
+static void SampleRenderBatch(void);
+
+// Fewest segments, rounded up to even (DrawCircleSector emits them in pairs as quads), keeping the chord's
+// sagitta r (1 - cos(pi / segments)) within the error for a circle one pixel bigger than the table slot
+static void BuildCircleLodTable(void) {
+    for (int radius = 0; radius < CIRCLE_LOD_TABLE_RADIUS; radius++) {
+        float cosine = 1.0f - CIRCLE_LOD_MAX_ERROR / (float)(radius + 1);
+        int segments = (cosine > 0.0f) ? (int)ceilf(PI / acosf(cosine)) : CIRCLE_LOD_MIN_SEGMENTS;
+        segments += segments & 1;
+        if (segments < CIRCLE_LOD_MIN_SEGMENTS) segments = CIRCLE_LOD_MIN_SEGMENTS;
+        if (segments > CIRCLE_LOD_MAX_SEGMENTS) segments = CIRCLE_LOD_MAX_SEGMENTS;
+        lodSegments[radius] = (unsigned char)segments;
+    }
+}
+
+// White disc with a one pixel anti-aliased rim; draws tint it, so every colour shares the texture
+void InitCircleRenderer(void) {
+    BuildCircleLodTable();
+
+    Image image = GenImageColor(CIRCLE_SPRITE_SIZE, CIRCLE_SPRITE_SIZE, BLANK);
+    Color *pixels = (Color *)image.data;
+    const float centre = CIRCLE_SPRITE_SIZE * 0.5f;
+    const float radius = centre - 0.5f;
+
+    for (int y = 0; y < CIRCLE_SPRITE_SIZE; y++) {
+        for (int x = 0; x < CIRCLE_SPRITE_SIZE; x++) {
+            float dx = x + 0.5f - centre;
+            float dy = y + 0.5f - centre;
+            float coverage = radius - sqrtf(dx * dx + dy * dy) + 0.5f;
+            if (coverage <= 0.0f) continue;
+            if (coverage > 1.0f) coverage = 1.0f;
+            pixels[y * CIRCLE_SPRITE_SIZE + x] = (Color){ 255, 255, 255, (unsigned char)(coverage * 255.0f) };
+        }
+    }
+
+    circleSprite = LoadTextureFromImage(image);
+    UnloadImage(image);
+    GenTextureMipmaps(&circleSprite);
+    SetTextureFilter(circleSprite, TEXTURE_FILTER_TRILINEAR);
+}
+
+void UnloadCircleRenderer(void) {
+    if (circleSprite.id != 0) UnloadTexture(circleSprite);
+    circleSprite = (Texture2D){ 0 };
+
+    free(circleList.center);
+    free(circleList.radius);
+    free(circleList.color);
+    circleList = (CircleList){ 0 };
+}
+
+void SetCirclePath(CirclePath path) {
+    activePath = path;
+}
+
+CirclePath GetCirclePath(void) {
+    return activePath;
+}
+
+const char* CirclePathToString(CirclePath path) {
+    switch (path) {
+        case CIRCLE_PATH_SHAPES: return "shapes";
+        case CIRCLE_PATH_SPRITES: return "sprites";
+        default: return "unknown";
+    }
+}
+
+//
+/* Drawing: the sprite path keeps one RL_QUADS draw open with the sprite bound, so consecutive circles only append four vertices each. */
+//
+static bool UseSprites(void) {
+    return activePath == CIRCLE_PATH_SPRITES && circleSprite.id != 0;
+}
+
+void BeginCircles(void) {
+    SampleRenderBatch(); // Re-arms flush detection, so the overflow checks below stay O(1)
+    if (!UseSprites()) return;
+    rlSetTexture(circleSprite.id);
+    rlBegin(RL_QUADS);
+}
+
+void SetCircleCullRect(Rectangle view) {
+    cullMinX = view.x - CIRCLE_CULL_MARGIN;
+    cullMinY = view.y - CIRCLE_CULL_MARGIN;
+    cullMaxX = view.x + view.width + CIRCLE_CULL_MARGIN;
+    cullMaxY = view.y + view.height + CIRCLE_CULL_MARGIN;
+    cullEnabled = true;
+}
+
+void ClearCircleCullRect(void) {
+    cullEnabled = false;
+}
+
+void SetCircleZoom(float zoom) {
+    circleZoom = (zoom > 0.0f) ? zoom : 1.0f;
+}
+
+//
+/* Level of detail: 0 for culled, CIRCLE_LOD_IMPOSTOR for sub-pixel, otherwise the segment count to tessellate with. */
+//
+#define CIRCLE_LOD_CULLED 0
+#define CIRCLE_LOD_IMPOSTOR 1
+
+static int PickCircleLod(Vector2 center, float radius, bool sprites) {
+    if (cullEnabled && (center.x + radius < cullMinX || center.x - radius > cullMaxX || center.y + radius < cullMinY || center.y - radius > cullMaxY)) {
+        return CIRCLE_LOD_CULLED;
+    }
+
+    float screenRadius = radius * circleZoom;
+    if (screenRadius < CIRCLE_LOD_IMPOSTOR_RADIUS) return CIRCLE_LOD_IMPOSTOR;
+    if (sprites) return CIRCLE_LOD_MAX_SEGMENTS; // A sprite is one quad at any size
+    return (screenRadius < CIRCLE_LOD_TABLE_RADIUS) ? lodSegments[(int)screenRadius] : CIRCLE_LOD_MAX_SEGMENTS;
+}
+
+// Same winding as DrawTexturePro: top-left, bottom-left, bottom-right, top-right
+static void EmitSpriteQuad(Vector2 center, float half, float u0, float v0, float u1, float v1, Color color) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(center.x - half, center.y - half);
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(center.x - half, center.y + half);
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(center.x + half, center.y + half);
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(center.x + half, center.y - half);
+}
+
+static void EmitCircle(Vector2 center, float radius, int lod, Color color, bool sprites) {
+    circleStats.circles++;
+
+    if (lod == CIRCLE_LOD_IMPOSTOR) {
+        // One screen pixel, faded by how much of it the circle would have covered
+        float screenRadius = radius * circleZoom;
+        float coverage = PI * screenRadius * screenRadius;
+        if (coverage < 1.0f) color.a = (unsigned char)(color.a * coverage);
+        float half = 0.5f / circleZoom;
+
+        if (CheckCircleBatchLimit(CIRCLE_SPRITE_VERTICES)) circleStats.flushes++;
+        circleStats.vertices += CIRCLE_SPRITE_VERTICES;
+        circleStats.impostors++;
+        if (sprites) EmitSpriteQuad(center, half, 0.5f, 0.5f, 0.5f, 0.5f, color); // The sprite's opaque centre texel
+        else DrawRectangleV((Vector2){ center.x - half, center.y - half }, (Vector2){ 2.0f * half, 2.0f * half }, color);
+        return;
+    }
+
+    if (!sprites) {
+        // DrawCircleSector emits two segments per quad. Make room up front, so a flush it would trigger
+        // halfway through is counted here instead
+        int vertices = 2 * lod;
+        if (CheckCircleBatchLimit(vertices)) circleStats.flushes++;
+        circleStats.vertices += vertices;
+        DrawCircleSector(center, radius, 0.0f, 360.0f, lod, color);
+        return;
+    }
+
+    if (CheckCircleBatchLimit(CIRCLE_SPRITE_VERTICES)) circleStats.flushes++;
+    circleStats.vertices += CIRCLE_SPRITE_VERTICES;
+    EmitSpriteQuad(center, radius, 0.0f, 0.0f, 1.0f, 1.0f, color);
+}
+
+void DrawCircleBatched(Vector2 center, float radius, Color color) {
+    bool sprites = UseSprites();
+    int lod = PickCircleLod(center, radius, sprites);
+    if (lod == CIRCLE_LOD_CULLED) circleStats.culled++;
+    else EmitCircle(center, radius, lod, color, sprites);
+}
+
+static bool ReserveCircleArray(void **array, int capacity, size_t elementSize) {
+    void *grown = realloc(*array, capacity * elementSize);
+    if (grown == NULL) return false;
+    *array = grown;
+    return true;
+}
+
+CircleList* BeginCircleList(int count) {
+    if (count > circleList.capacity) {
+        int capacity = (circleList.capacity > 0) ? circleList.capacity : CIRCLE_LIST_CHUNK;
+        while (capacity < count) capacity *= 2;
+        bool grown = ReserveCircleArray((void **)&circleList.center, capacity, sizeof(Vector2)) &&
+            ReserveCircleArray((void **)&circleList.radius, capacity, sizeof(float)) &&
+            ReserveCircleArray((void **)&circleList.color, capacity, sizeof(Color));
+        if (!grown) return NULL;
+        circleList.capacity = capacity;
+    }
+    circleList.count = 0;
+    return &circleList;
+}
+
+void DrawCircleList(const CircleList *list) {
+    bool sprites = UseSprites();
+    unsigned char lods[CIRCLE_LIST_CHUNK];
+
+    for (int start = 0; start < list->count; start += CIRCLE_LIST_CHUNK) {
+        int count = (list->count - start < CIRCLE_LIST_CHUNK) ? list->count - start : CIRCLE_LIST_CHUNK;
+        const Vector2 *center = &list->center[start];
+        const float *radius = &list->radius[start];
+        const Color *color = &list->color[start];
+
+        // Cull and pick every circle's LOD first, so the emit loop below only appends vertices
+        for (int i = 0; i < count; i++) lods[i] = (unsigned char)PickCircleLod(center[i], radius[i], sprites);
+
+        for (int i = 0; i < count; i++) {
+            if (lods[i] == CIRCLE_LOD_CULLED) circleStats.culled++;
+            else EmitCircle(center[i], radius[i], lods[i], color[i], sprites);
+        }
+    }
+}
+
+void EndCircles(void) {
+    if (!UseSprites()) return;
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void ResetCircleDrawStats(void) {
+    circleStats = (CircleDrawStats){ 0 };
+}
+
+CircleDrawStats GetCircleDrawStats(void) {
+    return circleStats;
+}
+
+//
+/* Render batch statistics: rlgl's own batch is private, so an identical one is installed and read directly. */
+//
+static rlRenderBatch statsBatch;
+static bool statsLoaded = false;
+static RenderSection activeSection = RENDER_SECTION_OTHER;
+static RenderFrameStats frameStats = { 0 };
+static RenderFrameStats lastFrameStats = { 0 };
+static RenderBatchStats sampled = { 0 }; // Batch contents at the last sample
+static unsigned int batchStartTexture = 0; // Texture bound when the batch's contents started
+static unsigned int sampledLastTexture = 0;
+static int closedDraws = -1; // Draws before the open one when closedVertexSlots was summed
+static int closedVertexSlots = 0;
+
+static bool BatchFlushedSinceSample(void) {
+    return statsBatch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].textureId != RENDER_BATCH_SENTINEL;
+}
+
+// Same test as rlCheckRenderBatchLimit on the vertex slots used, alignment padding included; the closed draws are only re-summed when they change
+static bool BatchWouldOverflow(int vertices) {
+    int open = statsBatch.drawCounter - 1;
+    if (open != closedDraws || BatchFlushedSinceSample()) {
+        closedVertexSlots = 0;
+        for (int i = 0; i < open; i++) closedVertexSlots += statsBatch.draws[i].vertexCount + statsBatch.draws[i].vertexAlignment;
+        closedDraws = open;
+    }
+    int used = closedVertexSlots + statsBatch.draws[open].vertexCount;
+    return used + vertices >= statsBatch.vertexBuffer[statsBatch.currentBuffer].elementCount * 4;
+}
+
+// Samples on both sides of a flush the circles themselves cause, so nothing they submitted goes unseen
+static bool CheckCircleBatchLimit(int vertices) {
+    if (!statsLoaded) return rlCheckRenderBatchLimit(vertices);
+
+    if (BatchWouldOverflow(vertices)) SampleRenderBatch();
+    bool flushed = rlCheckRenderBatchLimit(vertices);
+    if (flushed) SampleRenderBatch();
+    return flushed;
+}
+
+static RenderBatchStats MeasureRenderBatch(unsigned int *lastTexture) {
+    RenderBatchStats stats = { 0 };
+    unsigned int texture = batchStartTexture;
+    for (int i = 0; i < statsBatch.drawCounter; i++) {
+        const rlDrawCall *draw = &statsBatch.draws[i];
+        if (draw->vertexCount == 0) continue; // rlgl skips empty draws too
+        stats.drawCalls++;
+        stats.vertices += draw->vertexCount;
+        if (draw->textureId != texture) stats.textureSwitches++;
+        texture = draw->textureId;
+    }
+    *lastTexture = texture;
+    return stats;
+}
+
+// Attributes everything submitted since the last sample to the active section
+static void SampleRenderBatch(void) {
+    if (!statsLoaded) return;
+    RenderBatchStats *section = &frameStats.sections[activeSection];
+
+    if (BatchFlushedSinceSample()) {
+        if (sampled.vertices > 0) {
+            section->flushes++;
+            if (sampled.drawCalls > frameStats.peakDraws) frameStats.peakDraws = sampled.drawCalls;
+        }
+        batchStartTexture = sampledLastTexture;
+        sampled = (RenderBatchStats){ 0 };
+    }
+
+    unsigned int lastTexture;
+    RenderBatchStats now = MeasureRenderBatch(&lastTexture);
+    section->drawCalls += now.drawCalls - sampled.drawCalls;
+    section->vertices += now.vertices - sampled.vertices;
+    section->textureSwitches += now.textureSwitches - sampled.textureSwitches;
+    sampled = now;
+    sampledLastTexture = lastTexture;
+    statsBatch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].textureId = RENDER_BATCH_SENTINEL;
+}
+
+void InitRenderBatchStats(void) {
+    statsBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    rlSetRenderBatchActive(&statsBatch);
+    statsLoaded = true;
+    statsBatch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].textureId = RENDER_BATCH_SENTINEL;
+}
+
+void UnloadRenderBatchStats(void) {
+    if (!statsLoaded) return;
+    rlSetRenderBatchActive(NULL); // Draws what is left and goes back to rlgl's default batch
+    rlUnloadRenderBatch(statsBatch);
+    statsLoaded = false;
+}
+
+void BeginRenderFrame(void) {
+    memset(&frameStats, 0, sizeof(RenderFrameStats));
+    activeSection = RENDER_SECTION_OTHER;
+    SampleRenderBatch();
+}
+
+void BeginRenderSection(RenderSection section) {
+    SampleRenderBatch();
+    activeSection = section;
+}
+
+void FlushRenderBatch(void) {
+    SampleRenderBatch();
+    rlDrawRenderBatchActive();
+    SampleRenderBatch();
+}
+
+void EndRenderFrame(void) {
+    FlushRenderBatch();
+
+    RenderBatchStats *total = &frameStats.total;
+    for (int i = 0; i < RENDER_SECTION_COUNT; i++) {
+        total->flushes += frameStats.sections[i].flushes;
+        total->drawCalls += frameStats.sections[i].drawCalls;
+        total->vertices += frameStats.sections[i].vertices;
+        total->textureSwitches += frameStats.sections[i].textureSwitches;
+    }
+    lastFrameStats = frameStats;
+}
+
+const RenderFrameStats* GetRenderFrameStats(void) {
+    return &lastFrameStats;
+}
+
+const char* RenderSectionToString(RenderSection section) {
+    switch (section) {
+        case RENDER_SECTION_OTHER: return "other";
+        case RENDER_SECTION_HUD: return "hud";
+        case RENDER_SECTION_ARENA: return "arena";
+        case RENDER_SECTION_ENEMIES: return "enemies";
+        case RENDER_SECTION_PARTICLES: return "particles";
+        case RENDER_SECTION_BULLETS: return "bullets";
+        case RENDER_SECTION_TEXT: return "text";
+        default: return "unknown";
+    }
+}
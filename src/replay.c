@@ -0,0 +1,160 @@
+#include "replay.h"
+#include "globals.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const unsigned char replayMagic[4] = { 'R', 'B', 'H', 'R' };
+
+void InitReplay(Replay *replay, uint64_t seed, int arenaWidth, int arenaHeight) {
+    memset(replay, 0, sizeof(Replay));
+    replay->seed = seed;
+    replay->arenaWidth = arenaWidth;
+    replay->arenaHeight = arenaHeight;
+    replay->tickRate = TICK_RATE;
+}
+
+void UnloadReplay(Replay *replay) {
+    free(replay->inputs);
+    memset(replay, 0, sizeof(Replay));
+}
+
+static bool ReserveReplay(Replay *replay, long count) {
+    if (count <= replay->capacity) return true;
+
+    long capacity = (replay->capacity > 0) ? replay->capacity * 2 : TICK_RATE * 60L; // Start with a minute
+    if (capacity < count) capacity = count;
+    unsigned char *inputs = realloc(replay->inputs, capacity);
+    if (inputs == NULL) return false;
+
+    replay->inputs = inputs;
+    replay->capacity = capacity;
+    return true;
+}
+
+//
+/* Recording: one byte per tick, the same input GameLogic moves the player with. */
+//
+void RecordReplayTick(Replay *replay, unsigned char input) {
+    if (replay->pendingReset) input |= REPLAY_INPUT_RESET;
+
+    if (!ReserveReplay(replay, replay->tickCount + 1)) return;
+    replay->inputs[replay->tickCount++] = input;
+    replay->pendingReset = false;
+}
+
+void MarkReplayReset(Replay *replay) {
+    replay->pendingReset = true;
+}
+
+// Little-endian fixed-width fields and LEB128 run lengths, so files move between machines
+static void WriteU32(FILE *file, uint32_t value) {
+    for (int i = 0; i < 4; i++) fputc((int)((value >> (8 * i)) & 0xFF), file);
+}
+
+static void WriteU64(FILE *file, uint64_t value) {
+    for (int i = 0; i < 8; i++) fputc((int)((value >> (8 * i)) & 0xFF), file);
+}
+
+static void WriteVarint(FILE *file, uint64_t value) {
+    while (value >= 0x80) {
+        fputc((int)(value & 0x7F) | 0x80, file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static bool ReadU32(FILE *file, uint32_t *value) {
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        *value |= (uint32_t)c << (8 * i);
+    }
+    return true;
+}
+
+static bool ReadU64(FILE *file, uint64_t *value) {
+    *value = 0;
+    for (int i = 0; i < 8; i++) {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        *value |= (uint64_t)c << (8 * i);
+    }
+    return true;
+}
+
+static bool ReadVarint(FILE *file, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        *value |= (uint64_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// Layout: magic, version, tick rate, arena width, arena height, seed, tick count, then (input, run length) pairs
+bool SaveReplay(const Replay *replay, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    fwrite(replayMagic, 1, sizeof(replayMagic), file);
+    WriteU32(file, REPLAY_VERSION);
+    WriteU32(file, (uint32_t)replay->tickRate);
+    WriteU32(file, (uint32_t)replay->arenaWidth);
+    WriteU32(file, (uint32_t)replay->arenaHeight);
+    WriteU64(file, replay->seed);
+    WriteU64(file, (uint64_t)replay->tickCount);
+
+    for (long i = 0; i < replay->tickCount; ) {
+        long run = 1;
+        while (i + run < replay->tickCount && replay->inputs[i + run] == replay->inputs[i]) run++;
+        fputc(replay->inputs[i], file);
+        WriteVarint(file, (uint64_t)run);
+        i += run;
+    }
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
+
+bool LoadReplay(Replay *replay, const char *path) {
+    InitReplay(replay, 0, 0, 0);
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return false;
+
+    unsigned char magic[4];
+    uint32_t version, tickRate, arenaWidth, arenaHeight;
+    uint64_t seed, tickCount;
+    bool ok = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, replayMagic, sizeof(magic)) == 0 &&
+        ReadU32(file, &version) && version == REPLAY_VERSION &&
+        ReadU32(file, &tickRate) && ReadU32(file, &arenaWidth) && ReadU32(file, &arenaHeight) &&
+        ReadU64(file, &seed) && ReadU64(file, &tickCount);
+
+    if (ok) {
+        InitReplay(replay, seed, (int)arenaWidth, (int)arenaHeight);
+        replay->tickRate = (int)tickRate;
+        ok = ReserveReplay(replay, (long)tickCount);
+    }
+
+    while (ok && (uint64_t)replay->tickCount < tickCount) {
+        int input = fgetc(file);
+        uint64_t run;
+        if (input == EOF || !ReadVarint(file, &run) || run == 0 || run > tickCount - (uint64_t)replay->tickCount) {
+            ok = false;
+            break;
+        }
+        memset(replay->inputs + replay->tickCount, input, (size_t)run);
+        replay->tickCount += (long)run;
+    }
+
+    fclose(file);
+    if (!ok) {
+        TraceLog(LOG_WARNING, "REPLAY: [%s] Invalid or truncated replay file", path);
+        UnloadReplay(replay);
+    }
+    return ok;
+}
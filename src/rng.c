@@ -0,0 +1,35 @@
+#include "rng.h"
+
+// Each element depends only on key and its own index, so these loops have no carried state
+// and the compiler can unroll or vectorize them
+
+void RngFillU32(Rng *rng, uint32_t *out, int count) {
+    uint64_t key = rng->key;
+    uint64_t counter = rng->counter;
+    for (int i = 0; i < count; i++) {
+        out[i] = (uint32_t)(RngMix64(key + (counter + (uint64_t)i) * RNG_GAMMA) >> 32);
+    }
+    rng->counter = counter + (uint64_t)(count > 0 ? count : 0);
+}
+
+void RngFillFloat(Rng *rng, float *out, int count) {
+    uint64_t key = rng->key;
+    uint64_t counter = rng->counter;
+    for (int i = 0; i < count; i++) {
+        uint32_t bits = (uint32_t)(RngMix64(key + (counter + (uint64_t)i) * RNG_GAMMA) >> 32);
+        out[i] = (float)(bits >> 8) * 0x1p-24f;
+    }
+    rng->counter = counter + (uint64_t)(count > 0 ? count : 0);
+}
+
+void RngFillRange(Rng *rng, int *out, int count, int min, int max) {
+    if (max < min) { int t = min; min = max; max = t; }
+    uint64_t span = (uint64_t)((int64_t)max - min) + 1;
+    uint64_t key = rng->key;
+    uint64_t counter = rng->counter;
+    for (int i = 0; i < count; i++) {
+        uint32_t bits = (uint32_t)(RngMix64(key + (counter + (uint64_t)i) * RNG_GAMMA) >> 32);
+        out[i] = (int)((int64_t)min + (int64_t)(((uint64_t)bits * span) >> 32));
+    }
+    rng->counter = counter + (uint64_t)(count > 0 ? count : 0);
+}
@@ -0,0 +1,214 @@
+#include "scenario.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENARIO_LINE_LENGTH 256
+
+static void InitScenario(Scenario *scenario) {
+    memset(scenario, 0, sizeof(Scenario));
+    strcpy(scenario->name, "unnamed");
+    scenario->seed = GAME_DEFAULT_SEED;
+    scenario->ticks = TICK_RATE * 10L;
+    scenario->arenaWidth = ARENA_WIDTH;
+    scenario->arenaHeight = ARENA_HEIGHT;
+    scenario->wave = 1;
+    scenario->enemySpawnVar = INITIAL_ENEMY_SPAWN_VAR;
+    scenario->playerHealth = 10;
+}
+
+static int ParseEdges(const char *text) {
+    if (strcmp(text, "all") == 0) return SCENARIO_EDGE_ALL;
+
+    char copy[SCENARIO_LINE_LENGTH];
+    strncpy(copy, text, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+
+    int edges = 0;
+    for (char *edge = strtok(copy, ","); edge != NULL; edge = strtok(NULL, ",")) {
+        if (strcmp(edge, "top") == 0) edges |= SCENARIO_EDGE_TOP;
+        else if (strcmp(edge, "bottom") == 0) edges |= SCENARIO_EDGE_BOTTOM;
+        else if (strcmp(edge, "left") == 0) edges |= SCENARIO_EDGE_LEFT;
+        else if (strcmp(edge, "right") == 0) edges |= SCENARIO_EDGE_RIGHT;
+        else return 0;
+    }
+    return edges;
+}
+
+static bool ParseScenarioLine(Scenario *scenario, char *line) {
+    char key[32];
+    char value[SCENARIO_LINE_LENGTH];
+    if (sscanf(line, "%31s %255s", key, value) != 2) return false;
+
+    if (strcmp(key, "name") == 0) {
+        strncpy(scenario->name, value, SCENARIO_NAME_LENGTH - 1);
+        scenario->name[SCENARIO_NAME_LENGTH - 1] = '\0';
+    }
+    else if (strcmp(key, "seed") == 0) scenario->seed = (uint64_t)strtoull(value, NULL, 10);
+    else if (strcmp(key, "ticks") == 0) scenario->ticks = atol(value);
+    else if (strcmp(key, "warmup") == 0) scenario->warmupTicks = atol(value);
+    else if (strcmp(key, "width") == 0) scenario->arenaWidth = atoi(value);
+    else if (strcmp(key, "height") == 0) scenario->arenaHeight = atoi(value);
+    else if (strcmp(key, "wave") == 0) scenario->wave = atoi(value);
+    else if (strcmp(key, "wave_timer") == 0) scenario->waveTimer = (float)atof(value);
+    else if (strcmp(key, "spawn_var") == 0) scenario->enemySpawnVar = atoi(value);
+    else if (strcmp(key, "power_ups") == 0) scenario->powerUpsCollected = atoi(value);
+    else if (strcmp(key, "health") == 0) scenario->playerHealth = atoi(value);
+    else if (strcmp(key, "enemies") == 0) scenario->enemies = atoi(value);
+    else if (strcmp(key, "bullets") == 0) scenario->bullets = atoi(value);
+    else if (strcmp(key, "budget_p99_ms") == 0) scenario->budgetP99Ms = (float)atof(value);
+    else if (strcmp(key, "burst") == 0) {
+        ScenarioBurst burst = {0};
+        char edges[SCENARIO_LINE_LENGTH];
+        if (scenario->burstCount >= SCENARIO_MAX_BURSTS) return false;
+        if (sscanf(line, "%*s %ld %d %255s %ld", &burst.tick, &burst.count, edges, &burst.period) < 3) return false;
+        burst.edges = ParseEdges(edges);
+        if (burst.edges == 0 || burst.tick < 0 || burst.count < 0 || burst.period < 0) return false;
+        scenario->bursts[scenario->burstCount++] = burst;
+    }
+    else if (strcmp(key, "volley") == 0) {
+        ScenarioVolley volley = {0};
+        if (scenario->volleyCount >= SCENARIO_MAX_VOLLEYS) return false;
+        if (sscanf(line, "%*s %ld %d %ld", &volley.tick, &volley.count, &volley.period) < 2) return false;
+        if (volley.tick < 0 || volley.count < 0 || volley.period < 0) return false;
+        scenario->volleys[scenario->volleyCount++] = volley;
+    }
+    else return false;
+
+    return true;
+}
+
+bool LoadScenario(Scenario *scenario, const char *path) {
+    InitScenario(scenario);
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "SCENARIO: [%s] Failed to open file", path);
+        return false;
+    }
+
+    char line[SCENARIO_LINE_LENGTH];
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char *text = line;
+        while (isspace((unsigned char)*text)) text++;
+        if (*text == '\0') continue; // Blank or comment-only line
+
+        if (!ParseScenarioLine(scenario, text)) {
+            TraceLog(LOG_WARNING, "SCENARIO: [%s:%d] Invalid line: %s", path, lineNumber, text);
+            ok = false;
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
+
+//
+/* Placement draws from its own stream, past the game's, so a scenario never shifts gameplay randomness. */
+//
+static Rng GetScenarioRng(const Scenario *scenario, uint64_t id) {
+    Rng base = RngStream(scenario->seed, GAME_RNG_STREAM_COUNT);
+    return RngSubStream(&base, id);
+}
+
+// Sub-stream ids: 0 for the initial placement, then one per burst and volley, renewed on every repeat
+#define SCENARIO_RNG_IDS_PER_REPEAT (1 + SCENARIO_MAX_BURSTS + SCENARIO_MAX_VOLLEYS)
+
+// Which repeat of an event starting at first falls on tick, or -1 if none does
+static long GetRepeat(long first, long period, long tick) {
+    if (tick < first) return -1;
+    if (period == 0) return (tick == first) ? 0 : -1;
+    return ((tick - first) % period == 0) ? (tick - first) / period : -1;
+}
+
+static void FireScenarioBullets(GameLogicParams *params, int count, Rng *rng) {
+    const Player *player = params->player;
+    BulletManager *bulletManager = params->bulletManager;
+    for (int i = 0; i < count; i++) {
+        bool hasRoom = (bulletManager->slots.count < bulletManager->slots.capacity) || GrowBulletManager(bulletManager);
+        if (!hasRoom || SlotMapInsert(&bulletManager->slots).generation == 0) break;
+
+        float angle = RngNextFloat(rng) * 2.0f * PI;
+        Bullet *bullet = &bulletManager->bullets[bulletManager->slots.count - 1];
+        bullet->position = player->position;
+        bullet->previousPosition = player->position;
+        bullet->direction = (Vector2){ cosf(angle), sinf(angle) };
+        bullet->speed = PLAYER_SPEED * 4;
+        bullet->radius = 5.0f;
+        bullet->active = true;
+    }
+}
+
+void ApplyScenario(const Scenario *scenario, GameLogicParams *params) {
+    Player *player = params->player;
+    float arenaWidth = (float)params->platform->GetArenaWidth();
+    float arenaHeight = (float)params->platform->GetArenaHeight();
+
+    *(params->currentWave) = scenario->wave;
+    *(params->waveTimer) = scenario->waveTimer;
+    *(params->enemySpawnVar) = scenario->enemySpawnVar;
+    *(params->powerUpsCollected) = scenario->powerUpsCollected;
+    player->health = scenario->playerHealth;
+
+    // Keep initial enemies off the player so the first tick doesn't just remove them
+    Rng rng = GetScenarioRng(scenario, 0);
+    const float clearance = player->radius + ENEMY_RADIUS + 100.0f;
+    for (int i = 0; i < scenario->enemies; i++) {
+        float x = 0.0f, y = 0.0f;
+        for (int attempt = 0; attempt < 16; attempt++) { // Bounded, in case the arena is barely bigger than the player
+            x = RngNextFloat(&rng) * arenaWidth;
+            y = RngNextFloat(&rng) * arenaHeight;
+            if (Vector2Distance((Vector2){x, y}, player->position) >= clearance) break;
+        }
+        if (AddEnemy(params->enemies, x, y, ENEMY_RADIUS).generation == 0) break; // Pool ceiling reached
+    }
+
+    FireScenarioBullets(params, scenario->bullets, &rng);
+}
+
+void ApplyScenarioTick(const Scenario *scenario, GameLogicParams *params, long tick) {
+    float arenaWidth = (float)params->platform->GetArenaWidth();
+    float arenaHeight = (float)params->platform->GetArenaHeight();
+
+    for (int b = 0; b < scenario->burstCount; b++) {
+        const ScenarioBurst *burst = &scenario->bursts[b];
+        long repeat = GetRepeat(burst->tick, burst->period, tick);
+        if (repeat < 0) continue;
+
+        int edges[4];
+        int edgeCount = 0;
+        for (int e = 0; e < 4; e++) {
+            if (burst->edges & (1 << e)) edges[edgeCount++] = 1 << e;
+        }
+
+        // Round-robin over the chosen edges, uniform along each, like SpawnEnemy
+        Rng rng = GetScenarioRng(scenario, 1 + (uint64_t)b + (uint64_t)repeat * SCENARIO_RNG_IDS_PER_REPEAT);
+        for (int i = 0; i < burst->count; i++) {
+            float along = RngNextFloat(&rng);
+            Vector2 position = {0};
+            switch (edges[i % edgeCount]) {
+                case SCENARIO_EDGE_TOP: position = (Vector2){along * arenaWidth, 0}; break;
+                case SCENARIO_EDGE_BOTTOM: position = (Vector2){along * arenaWidth, arenaHeight}; break;
+                case SCENARIO_EDGE_LEFT: position = (Vector2){0, along * arenaHeight}; break;
+                case SCENARIO_EDGE_RIGHT: position = (Vector2){arenaWidth, along * arenaHeight}; break;
+            }
+            if (AddEnemy(params->enemies, position.x, position.y, ENEMY_RADIUS).generation == 0) break;
+        }
+    }
+
+    for (int v = 0; v < scenario->volleyCount; v++) {
+        const ScenarioVolley *volley = &scenario->volleys[v];
+        long repeat = GetRepeat(volley->tick, volley->period, tick);
+        if (repeat < 0) continue;
+
+        Rng rng = GetScenarioRng(scenario, 1 + SCENARIO_MAX_BURSTS + (uint64_t)v + (uint64_t)repeat * SCENARIO_RNG_IDS_PER_REPEAT);
+        FireScenarioBullets(params, volley->count, &rng);
+    }
+}
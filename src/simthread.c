@@ -0,0 +1,226 @@
+#include "simthread.h"
+#include <stdlib.h>
+#include <string.h>
+
+//
+/* Triple buffer */
+//
+static bool ReserveArray(void **array, int capacity, size_t elementSize) {
+    void *grown = realloc(*array, capacity * elementSize);
+    if (grown == NULL) return false;
+    *array = grown;
+    return true;
+}
+
+static bool ReserveFloats(float **array, int capacity) {
+    return ReserveArray((void **)array, capacity, sizeof(float));
+}
+
+// Copies the live state into a slot, growing its arrays by doubling so a rising population reallocates rarely
+static void CaptureSnapshot(GameSnapshot *snapshot, const GameLogicParams *params) {
+    GameView live = GetGameView(params);
+
+    if (live.enemyCount > snapshot->enemyCapacity) {
+        int capacity = (snapshot->enemyCapacity > 0) ? snapshot->enemyCapacity : ENEMY_POOL_INITIAL;
+        while (capacity < live.enemyCount) capacity *= 2;
+        bool grown = ReserveFloats(&snapshot->enemyX, capacity) && ReserveFloats(&snapshot->enemyY, capacity) &&
+            ReserveFloats(&snapshot->enemyPreviousX, capacity) && ReserveFloats(&snapshot->enemyPreviousY, capacity) &&
+            ReserveFloats(&snapshot->enemyRadius, capacity);
+        if (grown) snapshot->enemyCapacity = capacity;
+    }
+    if (live.bulletCount > snapshot->bulletCapacity) {
+        int capacity = (snapshot->bulletCapacity > 0) ? snapshot->bulletCapacity : BULLET_POOL_INITIAL;
+        while (capacity < live.bulletCount) capacity *= 2;
+        if (ReserveArray((void **)&snapshot->bullets, capacity, sizeof(Bullet))) snapshot->bulletCapacity = capacity;
+    }
+    if (live.particleCount > snapshot->particleCapacity) {
+        int capacity = (snapshot->particleCapacity > 0) ? snapshot->particleCapacity : ENEMY_POOL_INITIAL;
+        while (capacity < live.particleCount) capacity *= 2;
+        bool grown = ReserveFloats(&snapshot->particleX, capacity) && ReserveFloats(&snapshot->particleY, capacity) &&
+            ReserveFloats(&snapshot->particleVX, capacity) && ReserveFloats(&snapshot->particleVY, capacity) &&
+            ReserveFloats(&snapshot->particleLife, capacity) && ReserveArray((void **)&snapshot->particleColor, capacity, sizeof(Color));
+        if (grown) snapshot->particleCapacity = capacity;
+    }
+
+    // Out of memory only drops the tail of the population from the picture, never the simulation
+    int enemies = (live.enemyCount < snapshot->enemyCapacity) ? live.enemyCount : snapshot->enemyCapacity;
+    int bullets = (live.bulletCount < snapshot->bulletCapacity) ? live.bulletCount : snapshot->bulletCapacity;
+    if (enemies > 0) {
+        memcpy(snapshot->enemyX, live.enemyX, enemies * sizeof(float));
+        memcpy(snapshot->enemyY, live.enemyY, enemies * sizeof(float));
+        memcpy(snapshot->enemyPreviousX, live.enemyPreviousX, enemies * sizeof(float));
+        memcpy(snapshot->enemyPreviousY, live.enemyPreviousY, enemies * sizeof(float));
+        memcpy(snapshot->enemyRadius, live.enemyRadius, enemies * sizeof(float));
+    }
+    if (bullets > 0) memcpy(snapshot->bullets, live.bullets, bullets * sizeof(Bullet));
+    int particles = (live.particleCount < snapshot->particleCapacity) ? live.particleCount : snapshot->particleCapacity;
+    if (particles > 0) {
+        memcpy(snapshot->particleX, live.particleX, particles * sizeof(float));
+        memcpy(snapshot->particleY, live.particleY, particles * sizeof(float));
+        memcpy(snapshot->particleVX, live.particleVX, particles * sizeof(float));
+        memcpy(snapshot->particleVY, live.particleVY, particles * sizeof(float));
+        memcpy(snapshot->particleLife, live.particleLife, particles * sizeof(float));
+        memcpy(snapshot->particleColor, live.particleColor, particles * sizeof(Color));
+    }
+    memcpy(snapshot->powerUps, live.powerUps, live.powerUpCount * sizeof(PowerUp));
+
+    snapshot->view = live;
+    snapshot->view.enemyX = snapshot->enemyX;
+    snapshot->view.enemyY = snapshot->enemyY;
+    snapshot->view.enemyPreviousX = snapshot->enemyPreviousX;
+    snapshot->view.enemyPreviousY = snapshot->enemyPreviousY;
+    snapshot->view.enemyRadius = snapshot->enemyRadius;
+    snapshot->view.enemyCount = enemies;
+    snapshot->view.bullets = snapshot->bullets;
+    snapshot->view.bulletCount = bullets;
+    snapshot->view.powerUps = snapshot->powerUps;
+    snapshot->view.particleX = snapshot->particleX;
+    snapshot->view.particleY = snapshot->particleY;
+    snapshot->view.particleVX = snapshot->particleVX;
+    snapshot->view.particleVY = snapshot->particleVY;
+    snapshot->view.particleLife = snapshot->particleLife;
+    snapshot->view.particleColor = snapshot->particleColor;
+    snapshot->view.particleCount = particles;
+    snapshot->accumulator = params->accumulator;
+    snapshot->publishTime = GetTime();
+}
+
+// Writer side: hand the filled back slot over and take whichever slot was in the middle
+static void PublishSnapshot(SnapshotBuffer *buffer) {
+    buffer->back = __atomic_exchange_n(&buffer->middle, buffer->back | SNAPSHOT_FRESH, __ATOMIC_ACQ_REL) & 3;
+}
+
+const GameSnapshot* AcquireSnapshot(SimThread *sim, bool *fresh) {
+    SnapshotBuffer *buffer = &sim->snapshots;
+    *fresh = (__atomic_load_n(&buffer->middle, __ATOMIC_ACQUIRE) & SNAPSHOT_FRESH) != 0;
+    if (*fresh) {
+        buffer->front = __atomic_exchange_n(&buffer->middle, buffer->front, __ATOMIC_ACQ_REL) & 3;
+    }
+
+    // Interpolate by how far the wall clock has moved past the snapshot, like renderAlpha in StepGameLogic
+    GameSnapshot *snapshot = &buffer->slots[buffer->front];
+    float alpha = (float)(GetTime() - snapshot->publishTime + snapshot->accumulator) / FIXED_TIMESTEP;
+    snapshot->view.renderAlpha = Clamp(alpha, 0.0f, 1.0f);
+    return snapshot;
+}
+
+//
+/* Simulation thread. Its Platform reads keys from the input the main thread latched, since raylib's
+   keyboard state is only safe to read on the thread that polls it. */
+//
+static SimThread *activeSim = NULL;
+static Platform simPlatform;
+
+static bool SimIsKeyDown(int key) {
+    int input = __atomic_load_n(&activeSim->input, __ATOMIC_RELAXED);
+    switch (key) {
+        case KEY_W: case KEY_UP: return (input & REPLAY_INPUT_UP) != 0;
+        case KEY_S: case KEY_DOWN: return (input & REPLAY_INPUT_DOWN) != 0;
+        case KEY_A: case KEY_LEFT: return (input & REPLAY_INPUT_LEFT) != 0;
+        case KEY_D: case KEY_RIGHT: return (input & REPLAY_INPUT_RIGHT) != 0;
+        default: return false;
+    }
+}
+
+static void *RunSimThread(void *argument) {
+    SimThread *sim = (SimThread *)argument;
+    GameLogicParams *params = sim->params;
+    double last = GetTime();
+
+    while (__atomic_load_n(&sim->running, __ATOMIC_ACQUIRE)) {
+        double now = GetTime();
+        float frameTime = (float)(now - last);
+        last = now;
+
+        if (__atomic_load_n(&sim->paused, __ATOMIC_RELAXED)) {
+            WaitTime(FIXED_TIMESTEP); // Time spent paused is never simulated
+            continue;
+        }
+
+        params->autopilot = __atomic_load_n(&sim->autopilot, __ATOMIC_ACQUIRE);
+        if (StepGameLogic(params, frameTime) > 0) {
+            GameSnapshot *snapshot = &sim->snapshots.slots[sim->snapshots.back];
+            CaptureSnapshot(snapshot, params);
+            snapshot->stepMs = (float)((GetTime() - now) * 1000.0);
+            PublishSnapshot(&sim->snapshots);
+        }
+
+        // Sleep until the accumulator will cover the next tick
+        double wait = (FIXED_TIMESTEP - params->accumulator) - (GetTime() - now);
+        if (wait > 0.0) WaitTime(wait);
+    }
+    return NULL;
+}
+
+void InitSimThread(SimThread *sim, GameLogicParams *params) {
+    memset(sim, 0, sizeof(SimThread));
+    sim->params = params;
+    sim->snapshots.back = 0;
+    sim->snapshots.middle = 1;
+    sim->snapshots.front = 2;
+}
+
+void UnloadSimThread(SimThread *sim) {
+    StopSimThread(sim);
+    for (int i = 0; i < 3; i++) {
+        GameSnapshot *snapshot = &sim->snapshots.slots[i];
+        free(snapshot->enemyX);
+        free(snapshot->enemyY);
+        free(snapshot->enemyPreviousX);
+        free(snapshot->enemyPreviousY);
+        free(snapshot->enemyRadius);
+        free(snapshot->bullets);
+        free(snapshot->particleX);
+        free(snapshot->particleY);
+        free(snapshot->particleVX);
+        free(snapshot->particleVY);
+        free(snapshot->particleLife);
+        free(snapshot->particleColor);
+    }
+    memset(&sim->snapshots, 0, sizeof(SnapshotBuffer));
+}
+
+void StartSimThread(SimThread *sim) {
+    if (sim->running) return;
+
+    // The first frame after starting draws the state as it is now, not whatever was left from last time
+    int middle = sim->snapshots.middle & 3;
+    CaptureSnapshot(&sim->snapshots.slots[middle], sim->params);
+    sim->snapshots.middle = middle | SNAPSHOT_FRESH;
+
+    activeSim = sim;
+    sim->platform = sim->params->platform;
+    simPlatform = *sim->platform;
+    simPlatform.IsKeyDown = SimIsKeyDown;
+    sim->params->platform = &simPlatform;
+    sim->autopilot = sim->params->autopilot;
+
+    sim->running = 1;
+    if (pthread_create(&sim->thread, NULL, RunSimThread, sim) != 0) {
+        TraceLog(LOG_WARNING, "SIMTHREAD: Failed to start, nothing will be simulated");
+        sim->running = 0;
+        sim->params->platform = sim->platform;
+    }
+}
+
+void StopSimThread(SimThread *sim) {
+    if (!sim->running) return;
+
+    __atomic_store_n(&sim->running, 0, __ATOMIC_RELEASE);
+    pthread_join(sim->thread, NULL);
+
+    // Give the params back their real platform, for ExitGameplay and the single-threaded path
+    sim->params->platform = sim->platform;
+}
+
+void SetSimThreadInput(SimThread *sim, unsigned char input) {
+    __atomic_store_n(&sim->input, (int)input, __ATOMIC_RELAXED);
+}
+
+void SetSimThreadPaused(SimThread *sim, bool paused) {
+    __atomic_store_n(&sim->paused, paused ? 1 : 0, __ATOMIC_RELAXED);
+}
+
+void SetSimThreadAutopilot(SimThread *sim, struct Autopilot *autopilot) {
+    __atomic_store_n(&sim->autopilot, autopilot, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,100 @@
+#include "slotmap.h"
+#include "poolmem.h"
+
+void InitSlotMap(SlotMap *map, int capacity, int maxCapacity) {
+    map->capacity = 0;
+    map->maxCapacity = maxCapacity;
+    map->count = 0;
+    map->generations = ReservePoolMemory(maxCapacity * sizeof(unsigned int));
+    map->slotToDense = ReservePoolMemory(maxCapacity * sizeof(int));
+    map->denseToSlot = ReservePoolMemory(maxCapacity * sizeof(int));
+
+    GrowSlotMap(map, capacity);
+}
+
+bool GrowSlotMap(SlotMap *map, int capacity) {
+    if (capacity > map->maxCapacity) capacity = map->maxCapacity;
+    if (capacity <= map->capacity) return capacity == map->capacity;
+    if (map->generations == NULL || map->slotToDense == NULL || map->denseToSlot == NULL) return false;
+
+    if (!CommitPoolMemory(map->generations, map->capacity * sizeof(unsigned int), capacity * sizeof(unsigned int)) ||
+        !CommitPoolMemory(map->slotToDense, map->capacity * sizeof(int), capacity * sizeof(int)) ||
+        !CommitPoolMemory(map->denseToSlot, map->capacity * sizeof(int), capacity * sizeof(int))) {
+        return false;
+    }
+
+    for (int i = map->capacity; i < capacity; i++) {
+        map->generations[i] = 1;
+        map->slotToDense[i] = -1;
+        map->denseToSlot[i] = i; // New slots join the free tail
+    }
+    map->capacity = capacity;
+    return true;
+}
+
+void UnloadSlotMap(SlotMap *map) {
+    ReleasePoolMemory(map->generations, map->maxCapacity * sizeof(unsigned int), map->capacity * sizeof(unsigned int));
+    ReleasePoolMemory(map->slotToDense, map->maxCapacity * sizeof(int), map->capacity * sizeof(int));
+    ReleasePoolMemory(map->denseToSlot, map->maxCapacity * sizeof(int), map->capacity * sizeof(int));
+    map->generations = NULL;
+    map->slotToDense = NULL;
+    map->denseToSlot = NULL;
+    map->capacity = 0;
+    map->maxCapacity = 0;
+    map->count = 0;
+}
+
+void ClearSlotMap(SlotMap *map) {
+    // Invalidate every outstanding handle; the free tail keeps its slots
+    for (int i = 0; i < map->count; i++) {
+        int slot = map->denseToSlot[i];
+        map->generations[slot]++;
+        if (map->generations[slot] == 0) map->generations[slot] = 1;
+        map->slotToDense[slot] = -1;
+    }
+    map->count = 0;
+}
+
+Handle SlotMapInsert(SlotMap *map) {
+    if (map->count >= map->capacity) return NULL_HANDLE;
+
+    int dense = map->count++;
+    int slot = map->denseToSlot[dense];
+    map->slotToDense[slot] = dense;
+    return (Handle){ slot, map->generations[slot] };
+}
+
+int SlotMapRemove(SlotMap *map, int denseIndex) {
+    if (denseIndex < 0 || denseIndex >= map->count) return -1;
+
+    int last = --map->count;
+    int slot = map->denseToSlot[denseIndex];
+
+    // Move the last live entry into the hole and park the freed slot on the free tail
+    int lastSlot = map->denseToSlot[last];
+    map->denseToSlot[denseIndex] = lastSlot;
+    map->slotToDense[lastSlot] = denseIndex;
+    map->denseToSlot[last] = slot;
+    map->slotToDense[slot] = -1;
+
+    map->generations[slot]++;
+    if (map->generations[slot] == 0) map->generations[slot] = 1; // Skip the never-valid generation on wrap
+
+    return (last != denseIndex) ? last : -1;
+}
+
+int SlotMapLookup(const SlotMap *map, Handle handle) {
+    if (handle.slot < 0 || handle.slot >= map->capacity) return -1;
+    if (map->generations[handle.slot] != handle.generation) return -1;
+    return map->slotToDense[handle.slot];
+}
+
+Handle SlotMapHandleAt(const SlotMap *map, int denseIndex) {
+    if (denseIndex < 0 || denseIndex >= map->count) return NULL_HANDLE;
+    int slot = map->denseToSlot[denseIndex];
+    return (Handle){ slot, map->generations[slot] };
+}
+
+bool IsHandleValid(const SlotMap *map, Handle handle) {
+    return SlotMapLookup(map, handle) >= 0;
+}
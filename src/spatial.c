@@ -0,0 +1,195 @@
+#include "spatial.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+void InitSpatialGrid(SpatialGrid *grid, float cellSize) {
+    memset(grid, 0, sizeof(SpatialGrid));
+    grid->baseCellSize = cellSize;
+    grid->cellSize = cellSize;
+    grid->invCellSize = 1.0f / cellSize;
+    grid->columns = 1;
+    grid->rows = 1;
+}
+
+void UnloadSpatialGrid(SpatialGrid *grid) {
+    free(grid->cellStart);
+    free(grid->cellCursor);
+    free(grid->items);
+    free(grid->itemCell);
+    free(grid->sortedX);
+    free(grid->sortedY);
+    free(grid->sortedRadius);
+    memset(grid, 0, sizeof(SpatialGrid));
+}
+
+static void ReserveSpatialGrid(SpatialGrid *grid, int cells, int count) {
+    if (cells + 1 > grid->cellCapacity) {
+        grid->cellCapacity = (cells + 1) * 2;
+        grid->cellStart = realloc(grid->cellStart, grid->cellCapacity * sizeof(int));
+        grid->cellCursor = realloc(grid->cellCursor, grid->cellCapacity * sizeof(int));
+    }
+    if (count > grid->itemCapacity) {
+        grid->itemCapacity = count * 2;
+        grid->items = realloc(grid->items, grid->itemCapacity * sizeof(int));
+        grid->itemCell = realloc(grid->itemCell, grid->itemCapacity * sizeof(int));
+        grid->sortedX = realloc(grid->sortedX, grid->itemCapacity * sizeof(float));
+        grid->sortedY = realloc(grid->sortedY, grid->itemCapacity * sizeof(float));
+        grid->sortedRadius = realloc(grid->sortedRadius, grid->itemCapacity * sizeof(float));
+    }
+}
+
+static int GetSpatialGridColumn(const SpatialGrid *grid, float x) {
+    int column = (int)((x - grid->originX) * grid->invCellSize);
+    if (column < 0) return 0;
+    if (column >= grid->columns) return grid->columns - 1;
+    return column;
+}
+
+static int GetSpatialGridRow(const SpatialGrid *grid, float y) {
+    int row = (int)((y - grid->originY) * grid->invCellSize);
+    if (row < 0) return 0;
+    if (row >= grid->rows) return grid->rows - 1;
+    return row;
+}
+
+void BuildSpatialGrid(SpatialGrid *grid, const float *x, const float *y, const float *radius, int count) {
+    grid->itemCount = count;
+    grid->maxRadius = 0.0f;
+
+    // Fit the grid to the bounds of the items, so it works for any arena size
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    if (count > 0) {
+        minX = maxX = x[0];
+        minY = maxY = y[0];
+    }
+    for (int i = 0; i < count; i++) {
+        if (x[i] < minX) minX = x[i];
+        if (x[i] > maxX) maxX = x[i];
+        if (y[i] < minY) minY = y[i];
+        if (y[i] > maxY) maxY = y[i];
+        if (radius[i] > grid->maxRadius) grid->maxRadius = radius[i];
+    }
+
+    grid->cellSize = grid->baseCellSize;
+    for (;;) {
+        grid->columns = (int)((maxX - minX) / grid->cellSize) + 1;
+        grid->rows = (int)((maxY - minY) / grid->cellSize) + 1;
+        if ((long)grid->columns * grid->rows <= SPATIAL_GRID_MAX_CELLS) break;
+        grid->cellSize *= 2.0f;
+    }
+    grid->invCellSize = 1.0f / grid->cellSize;
+    grid->originX = minX;
+    grid->originY = minY;
+
+    int cells = grid->columns * grid->rows;
+    ReserveSpatialGrid(grid, cells, count);
+
+    // Counting sort by cell; the scatter walks items in ascending order, so each cell stays sorted
+    memset(grid->cellStart, 0, (cells + 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        int cell = GetSpatialGridRow(grid, y[i]) * grid->columns + GetSpatialGridColumn(grid, x[i]);
+        grid->itemCell[i] = cell;
+        grid->cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cells; c++) {
+        grid->cellStart[c + 1] += grid->cellStart[c];
+    }
+    memcpy(grid->cellCursor, grid->cellStart, cells * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        int k = grid->cellCursor[grid->itemCell[i]]++;
+        grid->items[k] = i;
+        grid->sortedX[k] = x[i];
+        grid->sortedY[k] = y[i];
+        grid->sortedRadius[k] = radius[i];
+    }
+}
+
+void GetSpatialGridRange(const SpatialGrid *grid, float minX, float minY, float maxX, float maxY, int *column0, int *row0, int *column1, int *row1) {
+    *column0 = GetSpatialGridColumn(grid, minX);
+    *row0 = GetSpatialGridRow(grid, minY);
+    *column1 = GetSpatialGridColumn(grid, maxX);
+    *row1 = GetSpatialGridRow(grid, maxY);
+}
+
+// Keep the k best candidates sorted by (distance, index); ties go to the lower index like a linear scan
+static int InsertNearest(int index, float distanceSq, int found, int k, int *nearest, float *nearestDistanceSq) {
+    if (found == k) {
+        float worst = nearestDistanceSq[k - 1];
+        if (distanceSq > worst || (distanceSq == worst && index > nearest[k - 1])) return found;
+    }
+
+    int position = (found < k) ? found++ : k - 1;
+    while (position > 0 && (distanceSq < nearestDistanceSq[position - 1] ||
+           (distanceSq == nearestDistanceSq[position - 1] && index < nearest[position - 1]))) {
+        nearest[position] = nearest[position - 1];
+        nearestDistanceSq[position] = nearestDistanceSq[position - 1];
+        position--;
+    }
+    nearest[position] = index;
+    nearestDistanceSq[position] = distanceSq;
+    return found;
+}
+
+static int VisitNearestCell(const SpatialGrid *grid, int cell, float px, float py, float maxDistanceSq, int found, int k, int *nearest, float *nearestDistanceSq) {
+    for (int i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; i++) {
+        float dx = grid->sortedX[i] - px;
+        float dy = grid->sortedY[i] - py;
+        float distanceSq = dx*dx + dy*dy;
+        if (distanceSq < maxDistanceSq) found = InsertNearest(grid->items[i], distanceSq, found, k, nearest, nearestDistanceSq);
+    }
+    return found;
+}
+
+int QuerySpatialGridNearest(const SpatialGrid *grid, float px, float py, float maxDistance, int k, int *nearest, float *nearestDistanceSq) {
+    if (k <= 0 || grid->itemCount == 0) return 0;
+
+    float maxDistanceSq = maxDistance * maxDistance;
+    int found = 0;
+
+    // Query cell, unclamped: the point may lie outside the items' bounds
+    int column = (int)floorf((px - grid->originX) * grid->invCellSize);
+    int row = (int)floorf((py - grid->originY) * grid->invCellSize);
+
+    int maxRing = abs(column);
+    if (abs(column - (grid->columns - 1)) > maxRing) maxRing = abs(column - (grid->columns - 1));
+    if (abs(row) > maxRing) maxRing = abs(row);
+    if (abs(row - (grid->rows - 1)) > maxRing) maxRing = abs(row - (grid->rows - 1));
+
+    // Walk square rings of cells outwards; every cell on ring r is at least (r - 1) cells away
+    for (int ring = 0; ring <= maxRing; ring++) {
+        if (ring > 1) {
+            float bound = (ring - 1) * grid->cellSize;
+            float boundSq = bound * bound;
+            if (boundSq >= maxDistanceSq) break;
+            if (found == k && boundSq > nearestDistanceSq[k - 1]) break;
+        }
+
+        for (int r = row - ring; r <= row + ring; r++) {
+            if (r < 0 || r >= grid->rows) continue;
+            bool edgeRow = (r == row - ring) || (r == row + ring);
+            int step = (edgeRow || ring == 0) ? 1 : 2 * ring;
+            for (int c = column - ring; c <= column + ring; c += step) {
+                if (c < 0 || c >= grid->columns) continue;
+                found = VisitNearestCell(grid, r * grid->columns + c, px, py, maxDistanceSq, found, k, nearest, nearestDistanceSq);
+            }
+        }
+    }
+
+    return found;
+}
+
+int QueryNearestBruteForce(const float *x, const float *y, int count, float px, float py, float maxDistance, int k, int *nearest, float *nearestDistanceSq) {
+    if (k <= 0) return 0;
+
+    float maxDistanceSq = maxDistance * maxDistance;
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        float dx = x[i] - px;
+        float dy = y[i] - py;
+        float distanceSq = dx*dx + dy*dy;
+        if (distanceSq < maxDistanceSq) found = InsertNearest(i, distanceSq, found, k, nearest, nearestDistanceSq);
+    }
+    return found;
+}
@@ -0,0 +1,129 @@
+#include "statehash.h"
+#include <inttypes.h>
+#include <string.h>
+
+static const char *stateFieldNames[STATE_FIELD_COUNT] = {
+    "player", "enemies", "bullets", "power_ups", "counters", "wave", "rng"
+};
+
+//
+/* Hashing: every value is folded in as a 64-bit word through the RNG's finalizer, field by field, never as raw struct bytes, so padding can't leak in. */
+//
+static uint64_t HashWord(uint64_t hash, uint64_t word) {
+    return RngMix64(hash ^ word) + RNG_GAMMA;
+}
+
+static uint32_t FloatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t HashFloats(uint64_t hash, float a, float b) {
+    return HashWord(hash, ((uint64_t)FloatBits(a) << 32) | FloatBits(b));
+}
+
+static uint64_t HashPlayer(const Player *player) {
+    uint64_t hash = HashFloats(STATE_PLAYER, player->position.x, player->position.y);
+    hash = HashFloats(hash, player->radius, 0.0f);
+    return HashWord(hash, (uint64_t)(int64_t)player->health);
+}
+
+static uint64_t HashEnemies(const Enemies *enemies) {
+    uint64_t hash = HashWord(STATE_ENEMIES, (uint64_t)enemies->slots.count);
+    for (int i = 0; i < enemies->slots.count; i++) {
+        hash = HashFloats(hash, enemies->x[i], enemies->y[i]);
+        hash = HashWord(hash, ((uint64_t)FloatBits(enemies->radius[i]) << 8) | enemies->flags[i]);
+    }
+    return hash;
+}
+
+static uint64_t HashBullets(const BulletManager *bulletManager) {
+    uint64_t hash = HashWord(STATE_BULLETS, (uint64_t)bulletManager->slots.count);
+    hash = HashFloats(hash, bulletManager->lastShotTime, bulletManager->bulletCooldown);
+    for (int i = 0; i < bulletManager->slots.count; i++) {
+        const Bullet *bullet = &bulletManager->bullets[i];
+        hash = HashFloats(hash, bullet->position.x, bullet->position.y);
+        hash = HashFloats(hash, bullet->direction.x, bullet->direction.y);
+        hash = HashFloats(hash, bullet->speed, bullet->radius);
+        hash = HashWord(hash, bullet->active);
+    }
+    return hash;
+}
+
+static uint64_t HashPowerUps(const PowerUpManager *powerUpManager) {
+    uint64_t hash = HashWord(STATE_POWER_UPS, (uint64_t)powerUpManager->slots.count);
+    for (int i = 0; i < powerUpManager->slots.count; i++) {
+        const PowerUp *powerUp = &powerUpManager->powerUps[i];
+        hash = HashFloats(hash, powerUp->position.x, powerUp->position.y);
+        hash = HashFloats(hash, powerUp->radius, 0.0f);
+    }
+    return hash;
+}
+
+void HashGameState(const GameLogicParams *params, StateHash *hash) {
+    hash->fields[STATE_PLAYER] = HashPlayer(params->player);
+    hash->fields[STATE_ENEMIES] = HashEnemies(params->enemies);
+    hash->fields[STATE_BULLETS] = HashBullets(params->bulletManager);
+    hash->fields[STATE_POWER_UPS] = HashPowerUps(params->powerUpManager);
+
+    uint64_t counters = HashWord(STATE_COUNTERS, (uint64_t)(int64_t)*(params->powerUpsCollected));
+    counters = HashWord(counters, (uint64_t)(int64_t)*(params->enemiesShot));
+    counters = HashWord(counters, (uint64_t)(int64_t)*(params->enemySpawnVar));
+    hash->fields[STATE_COUNTERS] = counters;
+
+    uint64_t wave = HashWord(STATE_WAVE, (uint64_t)(int64_t)*(params->currentWave));
+    hash->fields[STATE_WAVE] = HashFloats(wave, *(params->waveTimer), 0.0f);
+
+    uint64_t rng = STATE_RNG;
+    for (int i = 0; i < GAME_RNG_STREAM_COUNT; i++) {
+        rng = HashWord(HashWord(rng, params->rng[i].key), params->rng[i].counter);
+    }
+    hash->fields[STATE_RNG] = rng;
+
+    hash->combined = 0;
+    for (int i = 0; i < STATE_FIELD_COUNT; i++) hash->combined = HashWord(hash->combined, hash->fields[i]);
+}
+
+const char* StateFieldToString(StateField field) {
+    return (field >= 0 && field < STATE_FIELD_COUNT) ? stateFieldNames[field] : "unknown";
+}
+
+//
+/* Hash log */
+//
+bool WriteStateHashHeader(FILE *file) {
+    if (fprintf(file, "# statehash v2: tick combined") < 0) return false;
+    for (int i = 0; i < STATE_FIELD_COUNT; i++) fprintf(file, " %s", stateFieldNames[i]);
+    return fprintf(file, "\n") >= 0;
+}
+
+void WriteStateHash(FILE *file, long tick, const StateHash *hash) {
+    fprintf(file, "%ld %016" PRIx64, tick, hash->combined);
+    for (int i = 0; i < STATE_FIELD_COUNT; i++) fprintf(file, " %016" PRIx64, hash->fields[i]);
+    fprintf(file, "\n");
+}
+
+bool ReadStateHash(FILE *file, long *tick, StateHash *hash) {
+    int c = fgetc(file);
+    while (c == '#') { // Header or comment line
+        while (c != '\n' && c != EOF) c = fgetc(file);
+        c = fgetc(file);
+    }
+    if (c == EOF) return false;
+    ungetc(c, file);
+
+    if (fscanf(file, "%ld %" SCNx64, tick, &hash->combined) != 2) return false;
+    for (int i = 0; i < STATE_FIELD_COUNT; i++) {
+        if (fscanf(file, " %" SCNx64, &hash->fields[i]) != 1) return false;
+    }
+    fscanf(file, " "); // Trailing newline, so the next call starts on a fresh line
+    return true;
+}
+
+int FindStateHashDivergence(const StateHash *a, const StateHash *b) {
+    for (int i = 0; i < STATE_FIELD_COUNT; i++) {
+        if (a->fields[i] != b->fields[i]) return i;
+    }
+    return -1;
+}
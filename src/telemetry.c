@@ -0,0 +1,140 @@
+#include "telemetry.h"
+#include "raylib.h"
+#include <string.h>
+
+//
+/* Histogram */
+//
+static int GetHistogramBucket(uint32_t valueUs) {
+    if (valueUs >= (1u << HISTOGRAM_MAX_BIT)) valueUs = (1u << HISTOGRAM_MAX_BIT) - 1;
+    if (valueUs < 2 * HISTOGRAM_SUB_BUCKETS) return (int)valueUs;
+
+    int highestBit = 31 - __builtin_clz(valueUs); // 7 or more here
+    int shift = highestBit - 6; // Keeps the top 7 bits, so valueUs >> shift is in [64, 128)
+    return 2 * HISTOGRAM_SUB_BUCKETS + (highestBit - 7) * HISTOGRAM_SUB_BUCKETS + (int)(valueUs >> shift) - HISTOGRAM_SUB_BUCKETS;
+}
+
+// Largest value that lands in the bucket
+static uint32_t GetHistogramBucketValue(int bucket) {
+    if (bucket < 2 * HISTOGRAM_SUB_BUCKETS) return (uint32_t)bucket;
+
+    int highestBit = 7 + (bucket - 2 * HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS;
+    uint32_t mantissa = HISTOGRAM_SUB_BUCKETS + (uint32_t)((bucket - 2 * HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS);
+    int shift = highestBit - 6;
+    return (mantissa << shift) + (1u << shift) - 1;
+}
+
+void ResetHistogram(Histogram *histogram) {
+    memset(histogram, 0, sizeof(Histogram));
+    histogram->minUs = UINT32_MAX;
+}
+
+void RecordHistogram(Histogram *histogram, uint32_t valueUs) {
+    histogram->counts[GetHistogramBucket(valueUs)]++;
+    histogram->totalCount++;
+    histogram->sumUs += valueUs;
+    if (valueUs < histogram->minUs) histogram->minUs = valueUs;
+    if (valueUs > histogram->maxUs) histogram->maxUs = valueUs;
+}
+
+uint32_t GetHistogramPercentile(const Histogram *histogram, double percentile) {
+    if (histogram->totalCount == 0) return 0;
+
+    // Rank of the sample at this percentile, 1-based, then walk the buckets up to it
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)histogram->totalCount + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > histogram->totalCount) rank = histogram->totalCount;
+
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram->counts[bucket];
+        if (seen >= rank) {
+            uint32_t value = GetHistogramBucketValue(bucket);
+            return (value < histogram->maxUs) ? value : histogram->maxUs;
+        }
+    }
+    return histogram->maxUs;
+}
+
+//
+/* Per-wave telemetry */
+//
+static const char *metricNames[TELEMETRY_METRIC_COUNT] = { "frame", "update", "draw", "flushes", "draw_calls", "vertices", "texture_switches" };
+
+static void ResetTelemetryWave(Telemetry *telemetry, int wave, int enemySpawnVar) {
+    for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) ResetHistogram(&telemetry->histograms[i]);
+    telemetry->wave = wave;
+    telemetry->enemySpawnVar = enemySpawnVar;
+    telemetry->peakEnemies = 0;
+}
+
+bool InitTelemetry(Telemetry *telemetry, const char *csvPath) {
+    memset(telemetry, 0, sizeof(Telemetry));
+    ResetTelemetryWave(telemetry, 0, 0);
+
+    if (csvPath != NULL) {
+        telemetry->csv = fopen(csvPath, "w");
+        if (telemetry->csv == NULL) return false;
+        fprintf(telemetry->csv, "wave,enemy_spawn_var,peak_enemies,metric,unit,samples,p50,p90,p99,p999,max,mean\n");
+    }
+    return true;
+}
+
+void RecordTelemetryFrame(Telemetry *telemetry, float frameMs, float updateMs, float drawMs, const RenderBatchStats *batch, int wave, int enemySpawnVar, int enemies) {
+    // A new wave (or a restart back to wave 1) closes the previous one
+    if (wave != telemetry->wave) {
+        FlushTelemetry(telemetry);
+        ResetTelemetryWave(telemetry, wave, enemySpawnVar);
+    }
+
+    float values[TELEMETRY_TIME_METRIC_COUNT] = { frameMs, updateMs, drawMs };
+    for (int i = 0; i < TELEMETRY_TIME_METRIC_COUNT; i++) {
+        float us = values[i] * 1000.0f;
+        RecordHistogram(&telemetry->histograms[i], (us > 0.0f) ? (uint32_t)(us + 0.5f) : 0);
+    }
+    RecordHistogram(&telemetry->histograms[TELEMETRY_FLUSHES], (uint32_t)batch->flushes);
+    RecordHistogram(&telemetry->histograms[TELEMETRY_DRAW_CALLS], (uint32_t)batch->drawCalls);
+    RecordHistogram(&telemetry->histograms[TELEMETRY_VERTICES], (uint32_t)batch->vertices);
+    RecordHistogram(&telemetry->histograms[TELEMETRY_TEXTURE_SWITCHES], (uint32_t)batch->textureSwitches);
+    if (enemySpawnVar > telemetry->enemySpawnVar) telemetry->enemySpawnVar = enemySpawnVar;
+    if (enemies > telemetry->peakEnemies) telemetry->peakEnemies = enemies;
+
+    telemetry->sparkline[telemetry->sparklineNext] = frameMs;
+    telemetry->sparklineNext = (telemetry->sparklineNext + 1) % TELEMETRY_SPARKLINE_FRAMES;
+}
+
+void FlushTelemetry(Telemetry *telemetry) {
+    if (telemetry->histograms[TELEMETRY_FRAME].totalCount == 0) return;
+
+    for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) {
+        // Times are kept in us and reported in ms; counts are reported as they are
+        bool isTime = i < TELEMETRY_TIME_METRIC_COUNT;
+        float scale = isTime ? 1000.0f : 1.0f;
+        const char *unit = isTime ? "ms" : "count";
+
+        const Histogram *histogram = &telemetry->histograms[i];
+        float p50 = GetHistogramPercentile(histogram, 50.0) / scale;
+        float p90 = GetHistogramPercentile(histogram, 90.0) / scale;
+        float p99 = GetHistogramPercentile(histogram, 99.0) / scale;
+        float p999 = GetHistogramPercentile(histogram, 99.9) / scale;
+        float max = histogram->maxUs / scale;
+        float mean = (float)((double)histogram->sumUs / (double)histogram->totalCount / scale);
+
+        TraceLog(LOG_INFO, "TELEMETRY: Wave %d %-6s p50 %.2f p90 %.2f p99 %.2f p99.9 %.2f max %.2f %s (%llu frames)",
+            telemetry->wave, metricNames[i], p50, p90, p99, p999, max, unit, (unsigned long long)histogram->totalCount);
+        if (telemetry->csv != NULL) {
+            fprintf(telemetry->csv, "%d,%d,%d,%s,%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                telemetry->wave, telemetry->enemySpawnVar, telemetry->peakEnemies, metricNames[i], unit,
+                (unsigned long long)histogram->totalCount, p50, p90, p99, p999, max, mean);
+        }
+    }
+    if (telemetry->csv != NULL) fflush(telemetry->csv); // Rows survive a crash later in the session
+
+    ResetTelemetryWave(telemetry, telemetry->wave, telemetry->enemySpawnVar);
+}
+
+void UnloadTelemetry(Telemetry *telemetry) {
+    FlushTelemetry(telemetry);
+    if (telemetry->csv != NULL) fclose(telemetry->csv);
+    telemetry->csv = NULL;
+}